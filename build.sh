@@ -0,0 +1,11 @@
+#!/bin/sh
+
+DEBUG=${DEBUG:-1}
+IFLAGS="-Iinclude"
+CFLAGS="-o gltf2custom -std=gnu11 -Wall -Wextra -Wno-unused-function -D_GNU_SOURCE -ffast-math -pthread -lm"
+
+if [ "$DEBUG" = "1" ]; then
+  cc src/main.c $IFLAGS -O0 -g -DDEBUG=1 $CFLAGS
+else
+  cc src/main.c $IFLAGS -O2 -DNDEBUG $CFLAGS
+fi
@@ -145,12 +145,45 @@ typedef struct cgltf_file_options
 	void* user_data;
 } cgltf_file_options;
 
+typedef struct cgltf_parallel_options
+{
+	/* runs task over disjoint ranges covering [0, count), returns once all are done with 0 or the first negative task result */
+	int (*parallel_for)(void* user, cgltf_size count, int (*task)(void* task_data, cgltf_size begin, cgltf_size end), void* task_data);
+	cgltf_size min_elements; /* arrays with fewer elements are parsed serially, 0 == 4096 */
+	void* user_data;
+} cgltf_parallel_options;
+
+typedef enum cgltf_parse_section
+{
+	cgltf_parse_section_meshes = 1 << 0,
+	cgltf_parse_section_accessors = 1 << 1,
+	cgltf_parse_section_buffer_views = 1 << 2,
+	cgltf_parse_section_buffers = 1 << 3,
+	cgltf_parse_section_materials = 1 << 4,
+	cgltf_parse_section_images = 1 << 5,
+	cgltf_parse_section_textures = 1 << 6,
+	cgltf_parse_section_samplers = 1 << 7,
+	cgltf_parse_section_skins = 1 << 8,
+	cgltf_parse_section_cameras = 1 << 9,
+	cgltf_parse_section_nodes = 1 << 10,
+	cgltf_parse_section_scenes = 1 << 11, /* also covers the default "scene" */
+	cgltf_parse_section_animations = 1 << 12,
+	cgltf_parse_section_extras = 1 << 13,
+	cgltf_parse_section_extensions = 1 << 14, /* root extensions: lights, material variants, ... */
+	cgltf_parse_section_geometry_only = cgltf_parse_section_images | cgltf_parse_section_textures | cgltf_parse_section_samplers |
+		cgltf_parse_section_skins | cgltf_parse_section_cameras | cgltf_parse_section_nodes | cgltf_parse_section_scenes |
+		cgltf_parse_section_animations | cgltf_parse_section_extras | cgltf_parse_section_extensions,
+} cgltf_parse_section;
+
 typedef struct cgltf_options
 {
 	cgltf_file_type type; /* invalid == auto detect */
 	cgltf_size json_token_count; /* 0 == auto */
 	cgltf_memory_options memory;
 	cgltf_file_options file;
+	cgltf_bool json_single_pass; /* with json_token_count == 0, grow the token array while parsing instead of counting tokens first */
+	cgltf_uint skip_sections; /* cgltf_parse_section bits of top-level arrays to skip, 0 == parse everything; references into skipped sections are left NULL */
+	cgltf_parallel_options parallel; /* accessors, meshes and nodes elements are parsed and buffers loaded through parallel_for when set, memory.alloc_func and file.read must then be thread safe */
 } cgltf_options;
 
 typedef enum cgltf_buffer_view_type
@@ -903,6 +936,21 @@ cgltf_size cgltf_animation_channel_index(const cgltf_animation* animation, const
 #include <stdlib.h> /* For malloc, free, atoi, atof */
 #endif
 
+/*
+ * Instruction set of every vectorized routine (jsmn scanners, base64 decoding,
+ * index bounds), detected once so they can't disagree
+ */
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CGLTF_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CGLTF_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define CGLTF_SIMD_NEON
+#endif
+
 /* JSMN_PARENT_LINKS is necessary to make parsing large structures linear in input size */
 #define JSMN_PARENT_LINKS
 
@@ -1287,6 +1335,120 @@ static cgltf_result cgltf_load_buffer_file(const cgltf_options* options, cgltf_s
 	return result;
 }
 
+/*
+ * Vectorized base64 decoding, each step translates a block of characters to
+ * their 6-bit values and packs them into bytes. A block holding anything but
+ * [A-Za-z0-9+/] (padding, NUL, invalid characters) stops the vector loop and
+ * is left to the scalar decoder, which also reports errors.
+ */
+
+/* Decodes whole blocks while both the input and the output have room, returns the decoded byte count (3 per 4 characters). */
+static cgltf_size cgltf_decode_base64_blocks(const char* base64, cgltf_size length, unsigned char* data, cgltf_size size)
+{
+	cgltf_size in = 0, out = 0;
+
+#if defined(CGLTF_SIMD_AVX2)
+	/* 32 characters to 24 bytes, the store writes 32 */
+	const __m256i pack_lanes = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	const __m256i pack_halves = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+	for (; in + 32 <= length && out + 32 <= size; in += 32, out += 24)
+	{
+		__m256i chars = _mm256_loadu_si256((const __m256i*)(base64 + in));
+		__m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), chars));
+		__m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), chars));
+		__m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars));
+		__m256i plus = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('+'));
+		__m256i slash = _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('/'));
+		__m256i valid = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, plus)), slash);
+		if ((uint32_t)_mm256_movemask_epi8(valid) != 0xFFFFFFFFu)
+		{
+			break;
+		}
+
+		__m256i shift = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')), _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a'))),
+			_mm256_or_si256(_mm256_or_si256(_mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')), _mm256_and_si256(plus, _mm256_set1_epi8(62 - '+'))), _mm256_and_si256(slash, _mm256_set1_epi8(63 - '/'))));
+		__m256i values = _mm256_add_epi8(chars, shift);
+
+		/* 4 x 6 bits to 24 bits per 32-bit lane, first byte in bits 16-23 */
+		__m256i pairs = _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(values, _mm256_set1_epi16(0xFF)), 6), _mm256_srli_epi16(values, 8));
+		__m256i triples = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+		__m256i bytes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(triples, pack_lanes), pack_halves);
+		_mm256_storeu_si256((__m256i*)(data + out), bytes);
+	}
+#elif defined(CGLTF_SIMD_SSE2)
+	/* 16 characters to 12 bytes, the two 6 byte halves are written with overlapping 8 byte stores */
+	for (; in + 16 <= length && out + 16 <= size; in += 16, out += 12)
+	{
+		__m128i chars = _mm_loadu_si128((const __m128i*)(base64 + in));
+		__m128i upper = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('Z' + 1)));
+		__m128i lower = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('z' + 1)));
+		__m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+		__m128i plus = _mm_cmpeq_epi8(chars, _mm_set1_epi8('+'));
+		__m128i slash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('/'));
+		__m128i valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, plus)), slash);
+		if (_mm_movemask_epi8(valid) != 0xFFFF)
+		{
+			break;
+		}
+
+		__m128i shift = _mm_or_si128(_mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')), _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))),
+			_mm_or_si128(_mm_or_si128(_mm_and_si128(digit, _mm_set1_epi8(52 - '0')), _mm_and_si128(plus, _mm_set1_epi8(62 - '+'))), _mm_and_si128(slash, _mm_set1_epi8(63 - '/'))));
+		__m128i values = _mm_add_epi8(chars, shift);
+
+		/* 4 x 6 bits to 24 bits per 32-bit lane, first byte in bits 16-23 */
+		__m128i pairs = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(values, _mm_set1_epi16(0xFF)), 6), _mm_srli_epi16(values, 8));
+		__m128i triples = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+
+		/* byte swap each lane to output order, then pack two lanes per 64-bit half */
+		__m128i swapped = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(triples, _mm_set1_epi32(0xFF)), 16), _mm_and_si128(triples, _mm_set1_epi32(0xFF00))),
+			_mm_srli_epi32(triples, 16));
+		__m128i packed = _mm_or_si128(_mm_and_si128(swapped, _mm_set_epi32(0, 0xFFFFFF, 0, 0xFFFFFF)), _mm_srli_epi64(_mm_andnot_si128(_mm_set_epi32(0, 0xFFFFFF, 0, 0xFFFFFF), swapped), 8));
+		_mm_storel_epi64((__m128i*)(data + out), packed);
+		_mm_storel_epi64((__m128i*)(data + out + 6), _mm_unpackhi_epi64(packed, packed));
+	}
+#elif defined(CGLTF_SIMD_NEON)
+	/* 64 characters to 48 bytes, deinterleaved so each register holds one character of every group */
+	for (; in + 64 <= length && out + 48 <= size; in += 64, out += 48)
+	{
+		uint8x16x4_t chars = vld4q_u8((const uint8_t*)(base64 + in));
+		uint8x16_t valid = vdupq_n_u8(0xFF);
+
+		for (int k = 0; k < 4; ++k)
+		{
+			uint8x16_t c = chars.val[k];
+			uint8x16_t upper = vcltq_u8(vsubq_u8(c, vdupq_n_u8('A')), vdupq_n_u8(26));
+			uint8x16_t lower = vcltq_u8(vsubq_u8(c, vdupq_n_u8('a')), vdupq_n_u8(26));
+			uint8x16_t digit = vcltq_u8(vsubq_u8(c, vdupq_n_u8('0')), vdupq_n_u8(10));
+			uint8x16_t plus = vceqq_u8(c, vdupq_n_u8('+'));
+			uint8x16_t slash = vceqq_u8(c, vdupq_n_u8('/'));
+			uint8x16_t shift = vorrq_u8(vorrq_u8(vandq_u8(upper, vdupq_n_u8((uint8_t)-'A')), vandq_u8(lower, vdupq_n_u8((uint8_t)(26 - 'a')))),
+				vorrq_u8(vorrq_u8(vandq_u8(digit, vdupq_n_u8((uint8_t)(52 - '0'))), vandq_u8(plus, vdupq_n_u8(62 - '+'))), vandq_u8(slash, vdupq_n_u8(63 - '/'))));
+			valid = vandq_u8(valid, vorrq_u8(vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(digit, plus)), slash));
+			chars.val[k] = vaddq_u8(c, shift);
+		}
+
+		if (vminvq_u8(valid) != 0xFF)
+		{
+			break;
+		}
+
+		uint8x16x3_t bytes;
+		bytes.val[0] = vorrq_u8(vshlq_n_u8(chars.val[0], 2), vshrq_n_u8(chars.val[1], 4));
+		bytes.val[1] = vorrq_u8(vshlq_n_u8(chars.val[1], 4), vshrq_n_u8(chars.val[2], 2));
+		bytes.val[2] = vorrq_u8(vshlq_n_u8(chars.val[2], 6), chars.val[3]);
+		vst3q_u8(data + out, bytes);
+	}
+#else
+	(void)base64;
+	(void)length;
+	(void)data;
+	(void)size;
+#endif
+
+	(void)in;
+	return out;
+}
+
 cgltf_result cgltf_load_buffer_base64(const cgltf_options* options, cgltf_size size, const char* base64, void** out_data)
 {
 	void* (*memory_alloc)(void*, cgltf_size) = options->memory.alloc_func ? options->memory.alloc_func : &cgltf_default_alloc;
@@ -1298,10 +1460,14 @@ cgltf_result cgltf_load_buffer_base64(const cgltf_options* options, cgltf_size s
 		return cgltf_result_out_of_memory;
 	}
 
+	/* the vector loop never reads past the terminator, the scalar one stops on it */
+	cgltf_size decoded = cgltf_decode_base64_blocks(base64, strlen(base64), data, size);
+	base64 += decoded / 3 * 4;
+
 	unsigned int buffer = 0;
 	unsigned int buffer_bits = 0;
 
-	for (cgltf_size i = 0; i < size; ++i)
+	for (cgltf_size i = decoded; i < size; ++i)
 	{
 		while (buffer_bits < 8)
 		{
@@ -1445,6 +1611,80 @@ cgltf_size cgltf_decode_uri(char* uri)
 	return write - uri;
 }
 
+static cgltf_result cgltf_load_buffer(const cgltf_options* options, cgltf_buffer* buffer, const char* gltf_path)
+{
+	if (buffer->data)
+	{
+		return cgltf_result_success;
+	}
+
+	const char* uri = buffer->uri;
+
+	if (uri == NULL)
+	{
+		return cgltf_result_success;
+	}
+
+	if (strncmp(uri, "data:", 5) == 0)
+	{
+		const char* comma = strchr(uri, ',');
+
+		if (comma && comma - uri >= 7 && strncmp(comma - 7, ";base64", 7) == 0)
+		{
+			cgltf_result res = cgltf_load_buffer_base64(options, buffer->size, comma + 1, &buffer->data);
+			buffer->data_free_method = cgltf_data_free_method_memory_free;
+
+			if (res != cgltf_result_success)
+			{
+				return res;
+			}
+		}
+		else
+		{
+			return cgltf_result_unknown_format;
+		}
+	}
+	else if (strstr(uri, "://") == NULL && gltf_path)
+	{
+		cgltf_result res = cgltf_load_buffer_file(options, buffer->size, uri, gltf_path, &buffer->data);
+		buffer->data_free_method = cgltf_data_free_method_file_release;
+
+		if (res != cgltf_result_success)
+		{
+			return res;
+		}
+	}
+	else
+	{
+		return cgltf_result_unknown_format;
+	}
+
+	return cgltf_result_success;
+}
+
+typedef struct cgltf_load_buffers_job
+{
+	const cgltf_options* options;
+	cgltf_data* data;
+	const char* gltf_path;
+} cgltf_load_buffers_job;
+
+static int cgltf_load_buffers_task(void* task_data, cgltf_size begin, cgltf_size end)
+{
+	cgltf_load_buffers_job* job = (cgltf_load_buffers_job*)task_data;
+
+	for (cgltf_size i = begin; i < end; ++i)
+	{
+		cgltf_result res = cgltf_load_buffer(job->options, &job->data->buffers[i], job->gltf_path);
+		if (res != cgltf_result_success)
+		{
+			return -(int)res;
+		}
+	}
+
+	return 0;
+}
+
 cgltf_result cgltf_load_buffers(const cgltf_options* options, cgltf_data* data, const char* gltf_path)
 {
 	if (options == NULL)
@@ -1463,94 +1703,189 @@ cgltf_result cgltf_load_buffers(const cgltf_options* options, cgltf_data* data,
 		data->buffers[0].data_free_method = cgltf_data_free_method_none;
 	}
 
+	/* buffers are independent, with a parallel hook their reads overlap */
+	if (options->parallel.parallel_for && data->buffers_count > 1)
+	{
+		cgltf_load_buffers_job job = { options, data, gltf_path };
+		int result = options->parallel.parallel_for(options->parallel.user_data, data->buffers_count, &cgltf_load_buffers_task, &job);
+		return result < 0 ? (cgltf_result)-result : cgltf_result_success;
+	}
+
 	for (cgltf_size i = 0; i < data->buffers_count; ++i)
 	{
-		if (data->buffers[i].data)
+		cgltf_result res = cgltf_load_buffer(options, &data->buffers[i], gltf_path);
+		if (res != cgltf_result_success)
 		{
-			continue;
+			return res;
 		}
+	}
 
-		const char* uri = data->buffers[i].uri;
+	return cgltf_result_success;
+}
 
-		if (uri == NULL)
-		{
-			continue;
-		}
+/*
+ * Index maximum per component size, vector lanes keep running maxima that are
+ * reduced once at the end. SSE2 has no unsigned 16/32-bit max, values are
+ * biased into the signed range and compared instead.
+ */
+static cgltf_size cgltf_max_index_u8(const uint8_t* data, cgltf_size count)
+{
+	cgltf_size i = 0;
+	uint8_t bound = 0;
 
-		if (strncmp(uri, "data:", 5) == 0)
-		{
-			const char* comma = strchr(uri, ',');
+#if defined(CGLTF_SIMD_AVX2)
+	__m256i max = _mm256_setzero_si256();
+	for (; i + 32 <= count; i += 32)
+	{
+		max = _mm256_max_epu8(max, _mm256_loadu_si256((const __m256i*)(data + i)));
+	}
+	max = _mm256_max_epu8(max, _mm256_permute2x128_si256(max, max, 1));
+	__m128i lanes = _mm256_castsi256_si128(max);
+#elif defined(CGLTF_SIMD_SSE2)
+	__m128i lanes = _mm_setzero_si128();
+	for (; i + 16 <= count; i += 16)
+	{
+		lanes = _mm_max_epu8(lanes, _mm_loadu_si128((const __m128i*)(data + i)));
+	}
+#elif defined(CGLTF_SIMD_NEON)
+	uint8x16_t max = vdupq_n_u8(0);
+	for (; i + 16 <= count; i += 16)
+	{
+		max = vmaxq_u8(max, vld1q_u8(data + i));
+	}
+	bound = vmaxvq_u8(max);
+#endif
 
-			if (comma && comma - uri >= 7 && strncmp(comma - 7, ";base64", 7) == 0)
-			{
-				cgltf_result res = cgltf_load_buffer_base64(options, data->buffers[i].size, comma + 1, &data->buffers[i].data);
-				data->buffers[i].data_free_method = cgltf_data_free_method_memory_free;
+#if defined(CGLTF_SIMD_AVX2) || defined(CGLTF_SIMD_SSE2)
+	lanes = _mm_max_epu8(lanes, _mm_srli_si128(lanes, 8));
+	lanes = _mm_max_epu8(lanes, _mm_srli_si128(lanes, 4));
+	lanes = _mm_max_epu8(lanes, _mm_srli_si128(lanes, 2));
+	lanes = _mm_max_epu8(lanes, _mm_srli_si128(lanes, 1));
+	bound = (uint8_t)_mm_cvtsi128_si32(lanes);
+#endif
 
-				if (res != cgltf_result_success)
-				{
-					return res;
-				}
-			}
-			else
-			{
-				return cgltf_result_unknown_format;
-			}
-		}
-		else if (strstr(uri, "://") == NULL && gltf_path)
-		{
-			cgltf_result res = cgltf_load_buffer_file(options, data->buffers[i].size, uri, gltf_path, &data->buffers[i].data);
-			data->buffers[i].data_free_method = cgltf_data_free_method_file_release;
+	for (; i < count; ++i)
+	{
+		bound = bound > data[i] ? bound : data[i];
+	}
 
-			if (res != cgltf_result_success)
-			{
-				return res;
-			}
-		}
-		else
-		{
-			return cgltf_result_unknown_format;
-		}
+	return bound;
+}
+
+static cgltf_size cgltf_max_index_u16(const uint8_t* data, cgltf_size count)
+{
+	cgltf_size i = 0;
+	uint16_t bound = 0;
+
+#if defined(CGLTF_SIMD_AVX2)
+	__m256i max = _mm256_setzero_si256();
+	for (; i + 16 <= count; i += 16)
+	{
+		max = _mm256_max_epu16(max, _mm256_loadu_si256((const __m256i*)(data + i * 2)));
+	}
+	max = _mm256_max_epu16(max, _mm256_permute2x128_si256(max, max, 1));
+	const __m128i bias = _mm_set1_epi16((short)0x8000);
+	__m128i lanes = _mm_xor_si128(_mm256_castsi256_si128(max), bias);
+#elif defined(CGLTF_SIMD_SSE2)
+	const __m128i bias = _mm_set1_epi16((short)0x8000);
+	__m128i lanes = _mm_set1_epi16((short)0x8000);
+	for (; i + 8 <= count; i += 8)
+	{
+		lanes = _mm_max_epi16(lanes, _mm_xor_si128(_mm_loadu_si128((const __m128i*)(data + i * 2)), bias));
 	}
+#elif defined(CGLTF_SIMD_NEON)
+	uint16x8_t max = vdupq_n_u16(0);
+	for (; i + 8 <= count; i += 8)
+	{
+		max = vmaxq_u16(max, vld1q_u16((const uint16_t*)(data + i * 2)));
+	}
+	bound = vmaxvq_u16(max);
+#endif
 
-	return cgltf_result_success;
+#if defined(CGLTF_SIMD_AVX2) || defined(CGLTF_SIMD_SSE2)
+	lanes = _mm_max_epi16(lanes, _mm_srli_si128(lanes, 8));
+	lanes = _mm_max_epi16(lanes, _mm_srli_si128(lanes, 4));
+	lanes = _mm_max_epi16(lanes, _mm_srli_si128(lanes, 2));
+	bound = (uint16_t)(_mm_cvtsi128_si32(lanes) ^ 0x8000);
+#endif
+
+	for (; i < count; ++i)
+	{
+		uint16_t v = ((const uint16_t*)data)[i];
+		bound = bound > v ? bound : v;
+	}
+
+	return bound;
+}
+
+static cgltf_size cgltf_max_index_u32(const uint8_t* data, cgltf_size count)
+{
+	cgltf_size i = 0;
+	uint32_t bound = 0;
+
+#if defined(CGLTF_SIMD_AVX2)
+	__m256i max = _mm256_setzero_si256();
+	for (; i + 8 <= count; i += 8)
+	{
+		max = _mm256_max_epu32(max, _mm256_loadu_si256((const __m256i*)(data + i * 4)));
+	}
+	uint32_t lanes[8];
+	_mm256_storeu_si256((__m256i*)lanes, max);
+	for (int k = 0; k < 8; ++k)
+	{
+		bound = bound > lanes[k] ? bound : lanes[k];
+	}
+#elif defined(CGLTF_SIMD_SSE2)
+	const __m128i bias = _mm_set1_epi32((int)0x80000000u);
+	__m128i max = bias;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(data + i * 4)), bias);
+		__m128i greater = _mm_cmpgt_epi32(v, max);
+		max = _mm_or_si128(_mm_and_si128(greater, v), _mm_andnot_si128(greater, max));
+	}
+	uint32_t lanes[4];
+	_mm_storeu_si128((__m128i*)lanes, _mm_xor_si128(max, bias));
+	for (int k = 0; k < 4; ++k)
+	{
+		bound = bound > lanes[k] ? bound : lanes[k];
+	}
+#elif defined(CGLTF_SIMD_NEON)
+	uint32x4_t max = vdupq_n_u32(0);
+	for (; i + 4 <= count; i += 4)
+	{
+		max = vmaxq_u32(max, vld1q_u32((const uint32_t*)(data + i * 4)));
+	}
+	bound = vmaxvq_u32(max);
+#endif
+
+	for (; i < count; ++i)
+	{
+		uint32_t v = ((const uint32_t*)data)[i];
+		bound = bound > v ? bound : v;
+	}
+
+	return bound;
 }
 
 static cgltf_size cgltf_calc_index_bound(cgltf_buffer_view* buffer_view, cgltf_size offset, cgltf_component_type component_type, cgltf_size count)
 {
-	char* data = (char*)buffer_view->buffer->data + offset + buffer_view->offset;
-	cgltf_size bound = 0;
+	const uint8_t* data = (const uint8_t*)buffer_view->buffer->data + offset + buffer_view->offset;
 
 	switch (component_type)
 	{
 	case cgltf_component_type_r_8u:
-		for (size_t i = 0; i < count; ++i)
-		{
-			cgltf_size v = ((unsigned char*)data)[i];
-			bound = bound > v ? bound : v;
-		}
-		break;
+		return cgltf_max_index_u8(data, count);
 
 	case cgltf_component_type_r_16u:
-		for (size_t i = 0; i < count; ++i)
-		{
-			cgltf_size v = ((unsigned short*)data)[i];
-			bound = bound > v ? bound : v;
-		}
-		break;
+		return cgltf_max_index_u16(data, count);
 
 	case cgltf_component_type_r_32u:
-		for (size_t i = 0; i < count; ++i)
-		{
-			cgltf_size v = ((unsigned int*)data)[i];
-			bound = bound > v ? bound : v;
-		}
-		break;
+		return cgltf_max_index_u32(data, count);
 
 	default:
-		;
+		return 0;
 	}
-
-	return bound;
 }
 
 #if CGLTF_VALIDATE_ENABLE_ASSERTS
@@ -2642,8 +2977,8 @@ cgltf_size cgltf_accessor_unpack_indices(const cgltf_accessor* accessor, void* o
 #define CGLTF_CHECK_KEY(tok_) if ((tok_).type != JSMN_STRING || (tok_).size == 0) { return CGLTF_ERROR_JSON; } /* checking size for 0 verifies that a value follows the key */
 
 #define CGLTF_PTRINDEX(type, idx) (type*)((cgltf_size)idx + 1)
-#define CGLTF_PTRFIXUP(var, data, size) if (var) { if ((cgltf_size)var > size) { return CGLTF_ERROR_JSON; } var = &data[(cgltf_size)var-1]; }
-#define CGLTF_PTRFIXUP_REQ(var, data, size) if (!var || (cgltf_size)var > size) { return CGLTF_ERROR_JSON; } var = &data[(cgltf_size)var-1];
+#define CGLTF_PTRFIXUP(var, array, size) if (var) { if ((cgltf_size)var > size) { if (cgltf_fixup_skipped(data, skip_sections, &(array))) { var = NULL; } else { return CGLTF_ERROR_JSON; } } else { var = &array[(cgltf_size)var-1]; } }
+#define CGLTF_PTRFIXUP_REQ(var, array, size) if (!var || (cgltf_size)var > size) { if (var && cgltf_fixup_skipped(data, skip_sections, &(array))) { var = NULL; } else { return CGLTF_ERROR_JSON; } } else { var = &array[(cgltf_size)var-1]; }
 
 static int cgltf_json_strcmp(jsmntok_t const* tok, const uint8_t* json_chunk, const char* str)
 {
@@ -2653,6 +2988,156 @@ static int cgltf_json_strcmp(jsmntok_t const* tok, const uint8_t* json_chunk, co
 	return (str_len == name_length) ? strncmp((const char*)json_chunk + tok->start, str, str_len) : 128;
 }
 
+/*
+ * Keys of the hottest object parsers (accessor, buffer view, primitive and
+ * material), told apart by their length and one character then confirmed with
+ * a single memcmp, instead of one strcmp per candidate key.
+ */
+typedef enum cgltf_json_key
+{
+	cgltf_json_key_unknown,
+	cgltf_json_key_name,
+	cgltf_json_key_mode,
+	cgltf_json_key_type,
+	cgltf_json_key_min,
+	cgltf_json_key_max,
+	cgltf_json_key_count,
+	cgltf_json_key_buffer,
+	cgltf_json_key_target,
+	cgltf_json_key_sparse,
+	cgltf_json_key_extras,
+	cgltf_json_key_indices,
+	cgltf_json_key_targets,
+	cgltf_json_key_material,
+	cgltf_json_key_alpha_mode,
+	cgltf_json_key_buffer_view,
+	cgltf_json_key_byte_offset,
+	cgltf_json_key_byte_length,
+	cgltf_json_key_byte_stride,
+	cgltf_json_key_normalized,
+	cgltf_json_key_attributes,
+	cgltf_json_key_extensions,
+	cgltf_json_key_alpha_cutoff,
+	cgltf_json_key_double_sided,
+	cgltf_json_key_component_type,
+	cgltf_json_key_normal_texture,
+	cgltf_json_key_emissive_factor,
+	cgltf_json_key_emissive_texture,
+	cgltf_json_key_occlusion_texture,
+	cgltf_json_key_pbr_metallic_roughness,
+} cgltf_json_key;
+
+static const char* const cgltf_json_key_names[] =
+{
+	"",
+	"name",
+	"mode",
+	"type",
+	"min",
+	"max",
+	"count",
+	"buffer",
+	"target",
+	"sparse",
+	"extras",
+	"indices",
+	"targets",
+	"material",
+	"alphaMode",
+	"bufferView",
+	"byteOffset",
+	"byteLength",
+	"byteStride",
+	"normalized",
+	"attributes",
+	"extensions",
+	"alphaCutoff",
+	"doubleSided",
+	"componentType",
+	"normalTexture",
+	"emissiveFactor",
+	"emissiveTexture",
+	"occlusionTexture",
+	"pbrMetallicRoughness",
+};
+
+static cgltf_json_key cgltf_json_to_key(jsmntok_t const* tok, const uint8_t* json_chunk)
+{
+	const char* name = (const char*)json_chunk + tok->start;
+	int length = tok->end - tok->start;
+	cgltf_json_key key = cgltf_json_key_unknown;
+
+	switch (length)
+	{
+	case 3:
+		switch (name[1])
+		{
+		case 'i': key = cgltf_json_key_min; break;
+		case 'a': key = cgltf_json_key_max; break;
+		}
+		break;
+	case 4:
+		switch (name[0])
+		{
+		case 'n': key = cgltf_json_key_name; break;
+		case 'm': key = cgltf_json_key_mode; break;
+		case 't': key = cgltf_json_key_type; break;
+		}
+		break;
+	case 5: key = cgltf_json_key_count; break;
+	case 6:
+		switch (name[0])
+		{
+		case 'b': key = cgltf_json_key_buffer; break;
+		case 't': key = cgltf_json_key_target; break;
+		case 's': key = cgltf_json_key_sparse; break;
+		case 'e': key = cgltf_json_key_extras; break;
+		}
+		break;
+	case 7:
+		switch (name[0])
+		{
+		case 'i': key = cgltf_json_key_indices; break;
+		case 't': key = cgltf_json_key_targets; break;
+		}
+		break;
+	case 8: key = cgltf_json_key_material; break;
+	case 9: key = cgltf_json_key_alpha_mode; break;
+	case 10:
+		switch (name[4])
+		{
+		case 'e': key = cgltf_json_key_buffer_view; break;
+		case 'O': key = cgltf_json_key_byte_offset; break;
+		case 'L': key = cgltf_json_key_byte_length; break;
+		case 'S': key = cgltf_json_key_byte_stride; break;
+		case 'a': key = cgltf_json_key_normalized; break;
+		case 'i': key = cgltf_json_key_attributes; break;
+		case 'n': key = cgltf_json_key_extensions; break;
+		}
+		break;
+	case 11:
+		switch (name[0])
+		{
+		case 'a': key = cgltf_json_key_alpha_cutoff; break;
+		case 'd': key = cgltf_json_key_double_sided; break;
+		}
+		break;
+	case 13:
+		switch (name[0])
+		{
+		case 'c': key = cgltf_json_key_component_type; break;
+		case 'n': key = cgltf_json_key_normal_texture; break;
+		}
+		break;
+	case 14: key = cgltf_json_key_emissive_factor; break;
+	case 15: key = cgltf_json_key_emissive_texture; break;
+	case 16: key = cgltf_json_key_occlusion_texture; break;
+	case 20: key = cgltf_json_key_pbr_metallic_roughness; break;
+	}
+
+	return (key && memcmp(name, cgltf_json_key_names[key], length) == 0) ? key : cgltf_json_key_unknown;
+}
+
 static int cgltf_json_to_int(jsmntok_t const* tok, const uint8_t* json_chunk)
 {
 	CGLTF_CHECK_TOKTYPE(*tok, JSMN_PRIMITIVE);
@@ -2674,9 +3159,113 @@ static cgltf_size cgltf_json_to_size(jsmntok_t const* tok, const uint8_t* json_c
 	return res < 0 ? 0 : (cgltf_size)res;
 }
 
+/* the fast path relies on IEEE division being correctly rounded, keep fast-math from rewriting it */
+#if defined(_MSC_VER) || defined(__clang__)
+#pragma float_control(precise, on, push)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("no-fast-math")
+#endif
+
+/*
+ * Clinger's fast path: a decimal with at most 19 significant digits whose value
+ * fits in 53 bits, scaled by an exactly representable power of ten, is the
+ * correctly rounded double of a single multiplication or division. Returns 0
+ * when the token falls outside of that range and needs the strtod fallback.
+ */
+static cgltf_bool cgltf_json_to_double_fast(const char* str, cgltf_size length, double* out)
+{
+	static const double powers[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	const char* end = str + length;
+	cgltf_bool negative = 0;
+	uint64_t mantissa = 0;
+	int digits = 0;
+	int exponent = 0;
+
+	if (str < end && *str == '-')
+	{
+		negative = 1;
+		++str;
+	}
+
+	const char* first_digit = str;
+
+	for (; str < end && *str >= '0' && *str <= '9'; ++str)
+	{
+		if (mantissa || *str != '0') ++digits;
+		mantissa = mantissa * 10 + (uint64_t)(*str - '0');
+		if (digits > 19) return 0;
+	}
+
+	if (str == first_digit) return 0;
+
+	if (str < end && *str == '.')
+	{
+		const char* first_fraction = ++str;
+
+		for (; str < end && *str >= '0' && *str <= '9'; ++str)
+		{
+			if (mantissa || *str != '0') ++digits;
+			mantissa = mantissa * 10 + (uint64_t)(*str - '0');
+			if (digits > 19) return 0;
+		}
+
+		if (str == first_fraction) return 0;
+		exponent = -(int)(str - first_fraction);
+	}
+
+	if (str < end && (*str == 'e' || *str == 'E'))
+	{
+		++str;
+		cgltf_bool negative_exponent = 0;
+		int explicit_exponent = 0;
+
+		if (str < end && (*str == '-' || *str == '+'))
+		{
+			negative_exponent = *str == '-';
+			++str;
+		}
+
+		const char* first_exponent = str;
+
+		for (; str < end && *str >= '0' && *str <= '9'; ++str)
+		{
+			if (explicit_exponent < 10000) explicit_exponent = explicit_exponent * 10 + (*str - '0');
+		}
+
+		if (str == first_exponent) return 0;
+		exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+	}
+
+	if (str != end || mantissa > ((uint64_t)1 << 53) || exponent < -22 || exponent > 22)
+	{
+		return 0;
+	}
+
+	double value = (double)mantissa;
+	value = exponent < 0 ? value / powers[-exponent] : value * powers[exponent];
+	*out = negative ? -value : value;
+	return 1;
+}
+
+#if defined(_MSC_VER) || defined(__clang__)
+#pragma float_control(pop)
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
 static cgltf_float cgltf_json_to_float(jsmntok_t const* tok, const uint8_t* json_chunk)
 {
 	CGLTF_CHECK_TOKTYPE(*tok, JSMN_PRIMITIVE);
+	double value;
+	if (cgltf_json_to_double_fast((const char*)json_chunk + tok->start, (cgltf_size)(tok->end - tok->start), &value))
+	{
+		return (cgltf_float)value;
+	}
 	char tmp[128];
 	int size = (size_t)(tok->end - tok->start) < sizeof(tmp) ? (int)(tok->end - tok->start) : (int)(sizeof(tmp) - 1);
 	strncpy(tmp, (const char*)json_chunk + tok->start, size);
@@ -2786,6 +3375,78 @@ static int cgltf_parse_json_array(cgltf_options* options, jsmntok_t const* token
 	return i + 1;
 }
 
+typedef int (*cgltf_parse_json_element_func)(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, void* out_element);
+
+typedef struct cgltf_parallel_parse
+{
+	cgltf_options* options;
+	jsmntok_t const* tokens;
+	const uint8_t* json_chunk;
+	const int* starts;
+	uint8_t* elements;
+	size_t element_size;
+	cgltf_parse_json_element_func parse;
+} cgltf_parallel_parse;
+
+static int cgltf_parallel_parse_task(void* task_data, cgltf_size begin, cgltf_size end)
+{
+	cgltf_parallel_parse* job = (cgltf_parallel_parse*)task_data;
+
+	for (cgltf_size j = begin; j < end; ++j)
+	{
+		int i = job->parse(job->options, job->tokens, job->starts[j], job->json_chunk, job->elements + j * job->element_size);
+		if (i < 0)
+		{
+			return i;
+		}
+	}
+
+	return 0;
+}
+
+/* elements are independent subtrees, once their first tokens are known they can be parsed in any order */
+static int cgltf_parse_json_elements(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, void* elements, size_t element_size, cgltf_size count, cgltf_parse_json_element_func parse)
+{
+	cgltf_size min_elements = options->parallel.min_elements ? options->parallel.min_elements : 4096;
+
+	if (!options->parallel.parallel_for || count < min_elements)
+	{
+		for (cgltf_size j = 0; j < count; ++j)
+		{
+			i = parse(options, tokens, i, json_chunk, (uint8_t*)elements + j * element_size);
+			if (i < 0)
+			{
+				return i;
+			}
+		}
+		return i;
+	}
+
+	int* starts = (int*)options->memory.alloc_func(options->memory.user_data, sizeof(int) * count);
+	if (!starts)
+	{
+		return CGLTF_ERROR_NOMEM;
+	}
+
+	for (cgltf_size j = 0; j < count; ++j)
+	{
+		starts[j] = i;
+		i = cgltf_skip_json(tokens, i);
+		if (i < 0)
+		{
+			options->memory.free_func(options->memory.user_data, starts);
+			return i;
+		}
+	}
+
+	cgltf_parallel_parse job = { options, tokens, json_chunk, starts, (uint8_t*)elements, element_size, parse };
+	int result = options->parallel.parallel_for(options->parallel.user_data, count, &cgltf_parallel_parse_task, &job);
+
+	options->memory.free_func(options->memory.user_data, starts);
+
+	return result < 0 ? result : i;
+}
+
 static int cgltf_parse_json_string_array(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, char*** out_array, cgltf_size* out_size)
 {
 	CGLTF_CHECK_TOKTYPE(tokens[i], JSMN_ARRAY);
@@ -3227,30 +3888,31 @@ static int cgltf_parse_json_primitive(cgltf_options* options, jsmntok_t const* t
 	for (int j = 0; j < size; ++j)
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
+		cgltf_json_key key = cgltf_json_to_key(tokens + i, json_chunk);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "mode") == 0)
+		if (key == cgltf_json_key_mode)
 		{
 			++i;
 			out_prim->type = cgltf_json_to_primitive_type(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "indices") == 0)
+		else if (key == cgltf_json_key_indices)
 		{
 			++i;
 			out_prim->indices = CGLTF_PTRINDEX(cgltf_accessor, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "material") == 0)
+		else if (key == cgltf_json_key_material)
 		{
 			++i;
 			out_prim->material = CGLTF_PTRINDEX(cgltf_material, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "attributes") == 0)
+		else if (key == cgltf_json_key_attributes)
 		{
 			i = cgltf_parse_json_attribute_list(options, tokens, i + 1, json_chunk, &out_prim->attributes, &out_prim->attributes_count);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "targets") == 0)
+		else if (key == cgltf_json_key_targets)
 		{
 			i = cgltf_parse_json_array(options, tokens, i + 1, json_chunk, sizeof(cgltf_morph_target), (void**)&out_prim->targets, &out_prim->targets_count);
 			if (i < 0)
@@ -3267,11 +3929,11 @@ static int cgltf_parse_json_primitive(cgltf_options* options, jsmntok_t const* t
 				}
 			}
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (key == cgltf_json_key_extras)
 		{
 			i = cgltf_parse_json_extras(options, tokens, i + 1, json_chunk, &out_prim->extras);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensions") == 0)
+		else if (key == cgltf_json_key_extensions)
 		{
 			++i;
 
@@ -3425,6 +4087,11 @@ static int cgltf_parse_json_mesh(cgltf_options* options, jsmntok_t const* tokens
 	return i;
 }
 
+static int cgltf_parse_json_mesh_element(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, void* out_element)
+{
+	return cgltf_parse_json_mesh(options, tokens, i, json_chunk, (cgltf_mesh*)out_element);
+}
+
 static int cgltf_parse_json_meshes(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
 {
 	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_mesh), (void**)&out_data->meshes, &out_data->meshes_count);
@@ -3433,15 +4100,7 @@ static int cgltf_parse_json_meshes(cgltf_options* options, jsmntok_t const* toke
 		return i;
 	}
 
-	for (cgltf_size j = 0; j < out_data->meshes_count; ++j)
-	{
-		i = cgltf_parse_json_mesh(options, tokens, i, json_chunk, &out_data->meshes[j]);
-		if (i < 0)
-		{
-			return i;
-		}
-	}
-	return i;
+	return cgltf_parse_json_elements(options, tokens, i, json_chunk, out_data->meshes, sizeof(cgltf_mesh), out_data->meshes_count, &cgltf_parse_json_mesh_element);
 }
 
 static cgltf_component_type cgltf_json_to_component_type(jsmntok_t const* tok, const uint8_t* json_chunk)
@@ -3584,43 +4243,44 @@ static int cgltf_parse_json_accessor(cgltf_options* options, jsmntok_t const* to
 	for (int j = 0; j < size; ++j)
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
+		cgltf_json_key key = cgltf_json_to_key(tokens + i, json_chunk);
 
-		if (cgltf_json_strcmp(tokens + i, json_chunk, "name") == 0)
+		if (key == cgltf_json_key_name)
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_accessor->name);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "bufferView") == 0)
+		else if (key == cgltf_json_key_buffer_view)
 		{
 			++i;
 			out_accessor->buffer_view = CGLTF_PTRINDEX(cgltf_buffer_view, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteOffset") == 0)
+		else if (key == cgltf_json_key_byte_offset)
 		{
 			++i;
 			out_accessor->offset =
 					cgltf_json_to_size(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "componentType") == 0)
+		else if (key == cgltf_json_key_component_type)
 		{
 			++i;
 			out_accessor->component_type = cgltf_json_to_component_type(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "normalized") == 0)
+		else if (key == cgltf_json_key_normalized)
 		{
 			++i;
 			out_accessor->normalized = cgltf_json_to_bool(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "count") == 0)
+		else if (key == cgltf_json_key_count)
 		{
 			++i;
 			out_accessor->count = cgltf_json_to_size(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "type") == 0)
+		else if (key == cgltf_json_key_type)
 		{
 			++i;
 			if (cgltf_json_strcmp(tokens+i, json_chunk, "SCALAR") == 0)
@@ -3653,7 +4313,7 @@ static int cgltf_parse_json_accessor(cgltf_options* options, jsmntok_t const* to
 			}
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "min") == 0)
+		else if (key == cgltf_json_key_min)
 		{
 			++i;
 			out_accessor->has_min = 1;
@@ -3661,7 +4321,7 @@ static int cgltf_parse_json_accessor(cgltf_options* options, jsmntok_t const* to
 			int min_size = tokens[i].size > 16 ? 16 : tokens[i].size;
 			i = cgltf_parse_json_float_array(tokens, i, json_chunk, out_accessor->min, min_size);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "max") == 0)
+		else if (key == cgltf_json_key_max)
 		{
 			++i;
 			out_accessor->has_max = 1;
@@ -3669,16 +4329,16 @@ static int cgltf_parse_json_accessor(cgltf_options* options, jsmntok_t const* to
 			int max_size = tokens[i].size > 16 ? 16 : tokens[i].size;
 			i = cgltf_parse_json_float_array(tokens, i, json_chunk, out_accessor->max, max_size);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "sparse") == 0)
+		else if (key == cgltf_json_key_sparse)
 		{
 			out_accessor->is_sparse = 1;
 			i = cgltf_parse_json_accessor_sparse(tokens, i + 1, json_chunk, &out_accessor->sparse);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (key == cgltf_json_key_extras)
 		{
 			i = cgltf_parse_json_extras(options, tokens, i + 1, json_chunk, &out_accessor->extras);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensions") == 0)
+		else if (key == cgltf_json_key_extensions)
 		{
 			i = cgltf_parse_json_unprocessed_extensions(options, tokens, i, json_chunk, &out_accessor->extensions_count, &out_accessor->extensions);
 		}
@@ -4586,36 +5246,37 @@ static int cgltf_parse_json_material(cgltf_options* options, jsmntok_t const* to
 	for (int j = 0; j < size; ++j)
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
+		cgltf_json_key key = cgltf_json_to_key(tokens + i, json_chunk);
 
-		if (cgltf_json_strcmp(tokens+i, json_chunk, "name") == 0)
+		if (key == cgltf_json_key_name)
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_material->name);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "pbrMetallicRoughness") == 0)
+		else if (key == cgltf_json_key_pbr_metallic_roughness)
 		{
 			out_material->has_pbr_metallic_roughness = 1;
 			i = cgltf_parse_json_pbr_metallic_roughness(options, tokens, i + 1, json_chunk, &out_material->pbr_metallic_roughness);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "emissiveFactor") == 0)
+		else if (key == cgltf_json_key_emissive_factor)
 		{
 			i = cgltf_parse_json_float_array(tokens, i + 1, json_chunk, out_material->emissive_factor, 3);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "normalTexture") == 0)
+		else if (key == cgltf_json_key_normal_texture)
 		{
 			i = cgltf_parse_json_texture_view(options, tokens, i + 1, json_chunk,
 				&out_material->normal_texture);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "occlusionTexture") == 0)
+		else if (key == cgltf_json_key_occlusion_texture)
 		{
 			i = cgltf_parse_json_texture_view(options, tokens, i + 1, json_chunk,
 				&out_material->occlusion_texture);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "emissiveTexture") == 0)
+		else if (key == cgltf_json_key_emissive_texture)
 		{
 			i = cgltf_parse_json_texture_view(options, tokens, i + 1, json_chunk,
 				&out_material->emissive_texture);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "alphaMode") == 0)
+		else if (key == cgltf_json_key_alpha_mode)
 		{
 			++i;
 			if (cgltf_json_strcmp(tokens + i, json_chunk, "OPAQUE") == 0)
@@ -4632,24 +5293,24 @@ static int cgltf_parse_json_material(cgltf_options* options, jsmntok_t const* to
 			}
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "alphaCutoff") == 0)
+		else if (key == cgltf_json_key_alpha_cutoff)
 		{
 			++i;
 			out_material->alpha_cutoff = cgltf_json_to_float(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "doubleSided") == 0)
+		else if (key == cgltf_json_key_double_sided)
 		{
 			++i;
 			out_material->double_sided =
 				cgltf_json_to_bool(tokens + i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (key == cgltf_json_key_extras)
 		{
 			i = cgltf_parse_json_extras(options, tokens, i + 1, json_chunk, &out_material->extras);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensions") == 0)
+		else if (key == cgltf_json_key_extensions)
 		{
 			++i;
 
@@ -4758,6 +5419,11 @@ static int cgltf_parse_json_material(cgltf_options* options, jsmntok_t const* to
 	return i;
 }
 
+static int cgltf_parse_json_accessor_element(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, void* out_element)
+{
+	return cgltf_parse_json_accessor(options, tokens, i, json_chunk, (cgltf_accessor*)out_element);
+}
+
 static int cgltf_parse_json_accessors(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
 {
 	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_accessor), (void**)&out_data->accessors, &out_data->accessors_count);
@@ -4766,15 +5432,7 @@ static int cgltf_parse_json_accessors(cgltf_options* options, jsmntok_t const* t
 		return i;
 	}
 
-	for (cgltf_size j = 0; j < out_data->accessors_count; ++j)
-	{
-		i = cgltf_parse_json_accessor(options, tokens, i, json_chunk, &out_data->accessors[j]);
-		if (i < 0)
-		{
-			return i;
-		}
-	}
-	return i;
+	return cgltf_parse_json_elements(options, tokens, i, json_chunk, out_data->accessors, sizeof(cgltf_accessor), out_data->accessors_count, &cgltf_parse_json_accessor_element);
 }
 
 static int cgltf_parse_json_materials(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
@@ -4957,39 +5615,40 @@ static int cgltf_parse_json_buffer_view(cgltf_options* options, jsmntok_t const*
 	for (int j = 0; j < size; ++j)
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
+		cgltf_json_key key = cgltf_json_to_key(tokens + i, json_chunk);
 
-		if (cgltf_json_strcmp(tokens + i, json_chunk, "name") == 0)
+		if (key == cgltf_json_key_name)
 		{
 			i = cgltf_parse_json_string(options, tokens, i + 1, json_chunk, &out_buffer_view->name);
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "buffer") == 0)
+		else if (key == cgltf_json_key_buffer)
 		{
 			++i;
 			out_buffer_view->buffer = CGLTF_PTRINDEX(cgltf_buffer, cgltf_json_to_int(tokens + i, json_chunk));
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteOffset") == 0)
+		else if (key == cgltf_json_key_byte_offset)
 		{
 			++i;
 			out_buffer_view->offset =
 					cgltf_json_to_size(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteLength") == 0)
+		else if (key == cgltf_json_key_byte_length)
 		{
 			++i;
 			out_buffer_view->size =
 					cgltf_json_to_size(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "byteStride") == 0)
+		else if (key == cgltf_json_key_byte_stride)
 		{
 			++i;
 			out_buffer_view->stride =
 					cgltf_json_to_size(tokens+i, json_chunk);
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens+i, json_chunk, "target") == 0)
+		else if (key == cgltf_json_key_target)
 		{
 			++i;
 			int type = cgltf_json_to_int(tokens+i, json_chunk);
@@ -5008,11 +5667,11 @@ static int cgltf_parse_json_buffer_view(cgltf_options* options, jsmntok_t const*
 			out_buffer_view->type = (cgltf_buffer_view_type)type;
 			++i;
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extras") == 0)
+		else if (key == cgltf_json_key_extras)
 		{
 			i = cgltf_parse_json_extras(options, tokens, i + 1, json_chunk, &out_buffer_view->extras);
 		}
-		else if (cgltf_json_strcmp(tokens + i, json_chunk, "extensions") == 0)
+		else if (key == cgltf_json_key_extensions)
 		{
 			++i;
 
@@ -5720,6 +6379,11 @@ static int cgltf_parse_json_node(cgltf_options* options, jsmntok_t const* tokens
 	return i;
 }
 
+static int cgltf_parse_json_node_element(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, void* out_element)
+{
+	return cgltf_parse_json_node(options, tokens, i, json_chunk, (cgltf_node*)out_element);
+}
+
 static int cgltf_parse_json_nodes(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
 {
 	i = cgltf_parse_json_array(options, tokens, i, json_chunk, sizeof(cgltf_node), (void**)&out_data->nodes, &out_data->nodes_count);
@@ -5728,15 +6392,7 @@ static int cgltf_parse_json_nodes(cgltf_options* options, jsmntok_t const* token
 		return i;
 	}
 
-	for (cgltf_size j = 0; j < out_data->nodes_count; ++j)
-	{
-		i = cgltf_parse_json_node(options, tokens, i, json_chunk, &out_data->nodes[j]);
-		if (i < 0)
-		{
-			return i;
-		}
-	}
-	return i;
+	return cgltf_parse_json_elements(options, tokens, i, json_chunk, out_data->nodes, sizeof(cgltf_node), out_data->nodes_count, &cgltf_parse_json_node_element);
 }
 
 static int cgltf_parse_json_scene(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_scene* out_scene)
@@ -6213,7 +6869,40 @@ cgltf_size cgltf_calc_size(cgltf_type type, cgltf_component_type component_type)
 	return component_size * cgltf_num_components(type);
 }
 
-static int cgltf_fixup_pointers(cgltf_data* out_data);
+static int cgltf_fixup_pointers(cgltf_data* out_data, cgltf_uint skip_sections);
+
+static cgltf_bool cgltf_json_section_skipped(cgltf_uint skip_sections, jsmntok_t const* tok, const uint8_t* json_chunk)
+{
+	static const struct { const char* key; cgltf_uint section; } sections[] =
+	{
+		{ "meshes", cgltf_parse_section_meshes },
+		{ "accessors", cgltf_parse_section_accessors },
+		{ "bufferViews", cgltf_parse_section_buffer_views },
+		{ "buffers", cgltf_parse_section_buffers },
+		{ "materials", cgltf_parse_section_materials },
+		{ "images", cgltf_parse_section_images },
+		{ "textures", cgltf_parse_section_textures },
+		{ "samplers", cgltf_parse_section_samplers },
+		{ "skins", cgltf_parse_section_skins },
+		{ "cameras", cgltf_parse_section_cameras },
+		{ "nodes", cgltf_parse_section_nodes },
+		{ "scenes", cgltf_parse_section_scenes },
+		{ "scene", cgltf_parse_section_scenes },
+		{ "animations", cgltf_parse_section_animations },
+		{ "extras", cgltf_parse_section_extras },
+		{ "extensions", cgltf_parse_section_extensions },
+	};
+
+	for (cgltf_size k = 0; k < sizeof(sections) / sizeof(sections[0]); ++k)
+	{
+		if ((skip_sections & sections[k].section) && cgltf_json_strcmp(tok, json_chunk, sections[k].key) == 0)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
 
 static int cgltf_parse_json_root(cgltf_options* options, jsmntok_t const* tokens, int i, const uint8_t* json_chunk, cgltf_data* out_data)
 {
@@ -6226,7 +6915,11 @@ static int cgltf_parse_json_root(cgltf_options* options, jsmntok_t const* tokens
 	{
 		CGLTF_CHECK_KEY(tokens[i]);
 
-		if (cgltf_json_strcmp(tokens + i, json_chunk, "asset") == 0)
+		if (options->skip_sections && cgltf_json_section_skipped(options->skip_sections, tokens + i, json_chunk))
+		{
+			i = cgltf_skip_json(tokens, i + 1);
+		}
+		else if (cgltf_json_strcmp(tokens + i, json_chunk, "asset") == 0)
 		{
 			i = cgltf_parse_json_asset(options, tokens, i + 1, json_chunk, &out_data->asset);
 		}
@@ -6406,37 +7099,96 @@ static int cgltf_parse_json_root(cgltf_options* options, jsmntok_t const* tokens
 	return i;
 }
 
+static int cgltf_parse_json_tokens_growing(cgltf_options* options, const uint8_t* json_chunk, cgltf_size size, jsmntok_t** out_tokens)
+{
+	jsmn_parser parser;
+	jsmn_init(&parser);
+
+	/* glTF JSON averages more than 8 bytes per token, untouched capacity costs address space only */
+	cgltf_size capacity = size / 8 + 64;
+	jsmntok_t* tokens = (jsmntok_t*)options->memory.alloc_func(options->memory.user_data, sizeof(jsmntok_t) * (capacity + 1));
+
+	for (;;)
+	{
+		if (!tokens)
+		{
+			return JSMN_ERROR_NOMEM;
+		}
+
+		/* jsmn leaves the parser on the token it failed to allocate, so parsing resumes where it stopped */
+		int token_count = jsmn_parse(&parser, (const char*)json_chunk, size, tokens, capacity);
+
+		if (token_count != JSMN_ERROR_NOMEM)
+		{
+			*out_tokens = tokens;
+			return token_count;
+		}
+
+		cgltf_size grown_capacity = capacity * 2;
+		jsmntok_t* grown = (jsmntok_t*)options->memory.alloc_func(options->memory.user_data, sizeof(jsmntok_t) * (grown_capacity + 1));
+
+		if (grown)
+		{
+			memcpy(grown, tokens, sizeof(jsmntok_t) * parser.toknext);
+		}
+
+		options->memory.free_func(options->memory.user_data, tokens);
+		tokens = grown;
+		capacity = grown_capacity;
+	}
+}
+
 cgltf_result cgltf_parse_json(cgltf_options* options, const uint8_t* json_chunk, cgltf_size size, cgltf_data** out_data)
 {
 	jsmn_parser parser = { 0, 0, 0 };
+	jsmntok_t* tokens = NULL;
+	int token_count = 0;
 
-	if (options->json_token_count == 0)
+	if (options->json_token_count == 0 && options->json_single_pass)
 	{
-		int token_count = jsmn_parse(&parser, (const char*)json_chunk, size, NULL, 0);
+		token_count = cgltf_parse_json_tokens_growing(options, json_chunk, size, &tokens);
+
+		if (token_count == JSMN_ERROR_NOMEM)
+		{
+			return cgltf_result_out_of_memory;
+		}
 
 		if (token_count <= 0)
 		{
+			options->memory.free_func(options->memory.user_data, tokens);
 			return cgltf_result_invalid_json;
 		}
-
-		options->json_token_count = token_count;
 	}
+	else
+	{
+		if (options->json_token_count == 0)
+		{
+			token_count = jsmn_parse(&parser, (const char*)json_chunk, size, NULL, 0);
 
-	jsmntok_t* tokens = (jsmntok_t*)options->memory.alloc_func(options->memory.user_data, sizeof(jsmntok_t) * (options->json_token_count + 1));
+			if (token_count <= 0)
+			{
+				return cgltf_result_invalid_json;
+			}
 
-	if (!tokens)
-	{
-		return cgltf_result_out_of_memory;
-	}
+			options->json_token_count = token_count;
+		}
 
-	jsmn_init(&parser);
+		tokens = (jsmntok_t*)options->memory.alloc_func(options->memory.user_data, sizeof(jsmntok_t) * (options->json_token_count + 1));
 
-	int token_count = jsmn_parse(&parser, (const char*)json_chunk, size, tokens, options->json_token_count);
+		if (!tokens)
+		{
+			return cgltf_result_out_of_memory;
+		}
 
-	if (token_count <= 0)
-	{
-		options->memory.free_func(options->memory.user_data, tokens);
-		return cgltf_result_invalid_json;
+		jsmn_init(&parser);
+
+		token_count = jsmn_parse(&parser, (const char*)json_chunk, size, tokens, options->json_token_count);
+
+		if (token_count <= 0)
+		{
+			options->memory.free_func(options->memory.user_data, tokens);
+			return cgltf_result_invalid_json;
+		}
 	}
 
 	// this makes sure that we always have an UNDEFINED token at the end of the stream
@@ -6471,7 +7223,7 @@ cgltf_result cgltf_parse_json(cgltf_options* options, const uint8_t* json_chunk,
 		}
 	}
 
-	if (cgltf_fixup_pointers(data) < 0)
+	if (cgltf_fixup_pointers(data, options->skip_sections) < 0)
 	{
 		cgltf_free(data);
 		return cgltf_result_invalid_gltf;
@@ -6485,7 +7237,30 @@ cgltf_result cgltf_parse_json(cgltf_options* options, const uint8_t* json_chunk,
 	return cgltf_result_success;
 }
 
-static int cgltf_fixup_pointers(cgltf_data* data)
+/* true when array is the top-level array of a section in skip_sections, indices into it were never resolvable */
+static cgltf_bool cgltf_fixup_skipped(const cgltf_data* data, cgltf_uint skip_sections, const void* array)
+{
+	cgltf_uint section = 0;
+
+	if (array == &data->meshes) section = cgltf_parse_section_meshes;
+	else if (array == &data->accessors) section = cgltf_parse_section_accessors;
+	else if (array == &data->buffer_views) section = cgltf_parse_section_buffer_views;
+	else if (array == &data->buffers) section = cgltf_parse_section_buffers;
+	else if (array == &data->materials) section = cgltf_parse_section_materials;
+	else if (array == &data->images) section = cgltf_parse_section_images;
+	else if (array == &data->textures) section = cgltf_parse_section_textures;
+	else if (array == &data->samplers) section = cgltf_parse_section_samplers;
+	else if (array == &data->skins) section = cgltf_parse_section_skins;
+	else if (array == &data->cameras) section = cgltf_parse_section_cameras;
+	else if (array == &data->nodes) section = cgltf_parse_section_nodes;
+	else if (array == &data->scenes) section = cgltf_parse_section_scenes;
+	else if (array == &data->lights) section = cgltf_parse_section_extensions;
+
+	return (skip_sections & section) != 0;
+}
+
+/* indices into sections listed in skip_sections are left NULL, any other out-of-range index still fails */
+static int cgltf_fixup_pointers(cgltf_data* data, cgltf_uint skip_sections)
 {
 	for (cgltf_size i = 0; i < data->meshes_count; ++i)
 	{
@@ -6643,7 +7418,7 @@ static int cgltf_fixup_pointers(cgltf_data* data)
 		{
 			CGLTF_PTRFIXUP_REQ(data->scenes[i].nodes[j], data->nodes, data->nodes_count);
 
-			if (data->scenes[i].nodes[j]->parent)
+			if (data->scenes[i].nodes[j] && data->scenes[i].nodes[j]->parent)
 			{
 				return CGLTF_ERROR_JSON;
 			}
@@ -6774,6 +7549,126 @@ found:
 	return 0;
 }
 
+/**
+ * Vectorized scanners used by the string and whitespace loops, they look at
+ * 16 (32 with AVX2) bytes at a time and fall back to scalar code for the tail.
+ */
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+static unsigned jsmn_ctz(uint64_t mask) {
+	unsigned long index;
+#if defined(_M_X64) || defined(_M_ARM64)
+	_BitScanForward64(&index, mask);
+#else
+	/* _BitScanForward64 only exists on 64-bit targets, x86 masks fit in the low half */
+	if (_BitScanForward(&index, (unsigned long)mask)) return (unsigned)index;
+	_BitScanForward(&index, (unsigned long)(mask >> 32));
+	index += 32;
+#endif
+	return (unsigned)index;
+}
+#else
+static unsigned jsmn_ctz(uint64_t mask) {
+	return (unsigned)__builtin_ctzll(mask);
+}
+#endif
+
+/**
+ * Returns the offset of the first quote, backslash or NUL at or after pos,
+ * len if there is none.
+ */
+static size_t jsmn_scan_string(const char *js, size_t pos, size_t len) {
+#if defined(CGLTF_SIMD_AVX2)
+	const __m256i quote = _mm256_set1_epi8('\"');
+	const __m256i backslash = _mm256_set1_epi8('\\');
+	const __m256i zero = _mm256_setzero_si256();
+	for (; pos + 32 <= len; pos += 32) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i *)(js + pos));
+		__m256i hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+				_mm256_cmpeq_epi8(chunk, backslash)), _mm256_cmpeq_epi8(chunk, zero));
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(hits);
+		if (mask) return pos + jsmn_ctz(mask);
+	}
+#elif defined(CGLTF_SIMD_SSE2)
+	const __m128i quote = _mm_set1_epi8('\"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i zero = _mm_setzero_si128();
+	for (; pos + 16 <= len; pos += 16) {
+		__m128i chunk = _mm_loadu_si128((const __m128i *)(js + pos));
+		__m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+				_mm_cmpeq_epi8(chunk, backslash)), _mm_cmpeq_epi8(chunk, zero));
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(hits);
+		if (mask) return pos + jsmn_ctz(mask);
+	}
+#elif defined(CGLTF_SIMD_NEON)
+	const uint8x16_t quote = vdupq_n_u8('\"');
+	const uint8x16_t backslash = vdupq_n_u8('\\');
+	for (; pos + 16 <= len; pos += 16) {
+		uint8x16_t chunk = vld1q_u8((const uint8_t *)(js + pos));
+		uint8x16_t hits = vorrq_u8(vorrq_u8(vceqq_u8(chunk, quote),
+				vceqq_u8(chunk, backslash)), vceqzq_u8(chunk));
+		/* narrowing shift packs one nibble per byte into a 64-bit mask */
+		uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+		if (mask) return pos + (jsmn_ctz(mask) >> 2);
+	}
+#endif
+	for (; pos < len; pos++) {
+		char c = js[pos];
+		if (c == '\"' || c == '\\' || c == '\0') break;
+	}
+	return pos;
+}
+
+/**
+ * Returns the offset of the first non whitespace byte at or after pos,
+ * len if there is none.
+ */
+static size_t jsmn_skip_whitespace(const char *js, size_t pos, size_t len) {
+#if defined(CGLTF_SIMD_AVX2)
+	const __m256i space = _mm256_set1_epi8(' ');
+	const __m256i tab = _mm256_set1_epi8('\t');
+	const __m256i lf = _mm256_set1_epi8('\n');
+	const __m256i cr = _mm256_set1_epi8('\r');
+	for (; pos + 32 <= len; pos += 32) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i *)(js + pos));
+		__m256i blanks = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), _mm256_cmpeq_epi8(chunk, tab)),
+				_mm256_or_si256(_mm256_cmpeq_epi8(chunk, lf), _mm256_cmpeq_epi8(chunk, cr)));
+		uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(blanks);
+		if (mask) return pos + jsmn_ctz(mask);
+	}
+#elif defined(CGLTF_SIMD_SSE2)
+	const __m128i space = _mm_set1_epi8(' ');
+	const __m128i tab = _mm_set1_epi8('\t');
+	const __m128i lf = _mm_set1_epi8('\n');
+	const __m128i cr = _mm_set1_epi8('\r');
+	for (; pos + 16 <= len; pos += 16) {
+		__m128i chunk = _mm_loadu_si128((const __m128i *)(js + pos));
+		__m128i blanks = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, lf), _mm_cmpeq_epi8(chunk, cr)));
+		uint32_t mask = ~(uint32_t)_mm_movemask_epi8(blanks) & 0xFFFF;
+		if (mask) return pos + jsmn_ctz(mask);
+	}
+#elif defined(CGLTF_SIMD_NEON)
+	const uint8x16_t space = vdupq_n_u8(' ');
+	const uint8x16_t tab = vdupq_n_u8('\t');
+	const uint8x16_t lf = vdupq_n_u8('\n');
+	const uint8x16_t cr = vdupq_n_u8('\r');
+	for (; pos + 16 <= len; pos += 16) {
+		uint8x16_t chunk = vld1q_u8((const uint8_t *)(js + pos));
+		uint8x16_t blanks = vorrq_u8(vorrq_u8(vceqq_u8(chunk, space), vceqq_u8(chunk, tab)),
+				vorrq_u8(vceqq_u8(chunk, lf), vceqq_u8(chunk, cr)));
+		uint64_t mask = ~vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(blanks), 4)), 0);
+		if (mask) return pos + (jsmn_ctz(mask) >> 2);
+	}
+#endif
+	for (; pos < len; pos++) {
+		char c = js[pos];
+		if (c != ' ' && c != '\t' && c != '\n' && c != '\r') break;
+	}
+	return pos;
+}
+
 /**
  * Fills next token with JSON string.
  */
@@ -6787,7 +7682,15 @@ static int jsmn_parse_string(jsmn_parser *parser, const char *js,
 
 	/* Skip starting quote */
 	for (; parser->pos < len && js[parser->pos] != '\0'; parser->pos++) {
-		char c = js[parser->pos];
+		char c;
+
+		/* Jump straight to the next character that needs attention */
+		parser->pos = jsmn_scan_string(js, parser->pos, len);
+		if (parser->pos >= len || js[parser->pos] == '\0') {
+			break;
+		}
+
+		c = js[parser->pos];
 
 		/* Quote: end of string */
 		if (c == '\"') {
@@ -6932,6 +7835,8 @@ static int jsmn_parse(jsmn_parser *parser, const char *js, size_t len,
 				tokens[parser->toksuper].size++;
 			break;
 		case '\t' : case '\r' : case '\n' : case ' ':
+			/* Land on the last blank of the run, the loop increment steps past it */
+			parser->pos = jsmn_skip_whitespace(js, parser->pos, len) - 1;
 			break;
 		case ':':
 			parser->toksuper = parser->toknext - 1;
@@ -26,16 +26,47 @@
 #define DEFAULT_ALIGNMENT (2 * sizeof(void *))
 #endif
 
+// Reserved arenas grow their committed range by this granularity
+#ifndef ARENA_COMMIT_SIZE
+#define ARENA_COMMIT_SIZE (64 * KB)
+#endif
+
+// Address space reserved by each per-thread scratch arena
+#ifndef SCRATCH_ARENA_SIZE
+#define SCRATCH_ARENA_SIZE (4 * GB)
+#endif
+
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
+typedef struct ArenaStats {
+  size_t peak;
+  size_t allocCount;
+  size_t paddingBytes;
+  size_t scopePeak;
+  size_t tmpPeak;
+} ArenaStats;
+
 typedef struct Arena {
   size_t cur;
   size_t prev;
+  size_t dirty;
+  size_t committed;
+  size_t commitSize;
   size_t capacity;
+  i32 hugePages;
+  ArenaStats stats;
   uc *data;
 } Arena;
 
 typedef struct TmpArena {
   size_t prev;
   size_t cur;
+  size_t outerScopePeak;
+  size_t peak;
   Arena *arena;
 } TmpArena;
 
@@ -55,7 +86,8 @@ uintptr_t AlignForward(uintptr_t ptr, size_t align)
   return p;
 }
 
-void *AllocAlign(Arena *arena, size_t size, size_t align)
+// Memory is returned as is, use it for buffers that are fully overwritten
+void *AllocAlignNoZero(Arena *arena, size_t size, size_t align)
 {
   uintptr_t curr_ptr = (uintptr_t)arena->data + (uintptr_t)arena->cur;
   uintptr_t offset = AlignForward(curr_ptr, align);
@@ -63,10 +95,22 @@ void *AllocAlign(Arena *arena, size_t size, size_t align)
 
   if (offset + size <= arena->capacity)
   {
+    if (offset + size > arena->committed)
+    {
+      size_t committed = AlignForward(offset + size, arena->commitSize);
+      if (committed > arena->capacity) committed = arena->capacity;
+      if (!CommitPages(arena->data + arena->committed, committed - arena->committed)) return NULL;
+      arena->committed = committed;
+    }
+    
     void *ptr = &arena->data[offset];
+    arena->stats.allocCount++;
+    arena->stats.paddingBytes += offset - arena->cur;
     arena->prev = offset;
     arena->cur = offset + size;
-    memset(ptr, 0, size);
+    if (arena->cur > arena->dirty) arena->dirty = arena->cur;
+    if (arena->cur > arena->stats.peak) arena->stats.peak = arena->cur;
+    if (arena->cur > arena->stats.scopePeak) arena->stats.scopePeak = arena->cur;
     return ptr;
   }
   else
@@ -75,20 +119,87 @@ void *AllocAlign(Arena *arena, size_t size, size_t align)
   }
 }
 
+void *AllocAlign(Arena *arena, size_t size, size_t align)
+{
+  size_t dirty = arena->dirty;
+  uc *ptr = (uc *)AllocAlignNoZero(arena, size, align);
+  
+  // Bytes past the dirty mark were never handed out and are still zero
+  if (ptr && arena->prev < dirty)
+  {
+    size_t dirtySize = dirty - arena->prev;
+    memset(ptr, 0, dirtySize < size ? dirtySize : size);
+  }
+  
+  return ptr;
+}
+
 #define Alloc(arena, size) AllocAlign(arena, size, DEFAULT_ALIGNMENT)
+#define AllocNoZero(arena, size) AllocAlignNoZero(arena, size, DEFAULT_ALIGNMENT)
 #define New(arena, type) (type *)Alloc(arena, sizeof(type))
 
 void InitArena(Arena *arena, void *backBuffer, size_t backBufferLength)
 {
   arena->data = (uc *)backBuffer;
   arena->capacity = backBufferLength;
+  arena->committed = backBufferLength;
+  arena->commitSize = ARENA_COMMIT_SIZE;
+  arena->hugePages = 0;
+  arena->dirty = backBufferLength;
   arena->cur = 0;
   arena->prev = 0;
 }
 
+// Only reserves address space, pages get committed as allocations reach them.
+// Huge pages back the first hugePages bytes, on Win32 they are committed and
+// locked up front so callers size them from the input rather than capacity.
+// Huge pages are a hint, the arena silently falls back to regular pages.
+i32 ReserveArena(Arena *arena, size_t capacity, size_t hugePages)
+{
+  size_t committed = 0;
+  void *reserved = NULL;
+  
+  if (hugePages)
+  {
+    capacity = AlignForward(capacity, HUGE_PAGE_SIZE);
+    reserved = ReserveHugePages(capacity, hugePages, &committed);
+  }
+  
+  if (reserved)
+  {
+    InitArena(arena, reserved, capacity);
+    arena->commitSize = HUGE_PAGE_SIZE;
+    arena->hugePages = 1;
+  }
+  else
+  {
+    reserved = ReservePages(capacity);
+    if (!reserved) return 0;
+    InitArena(arena, reserved, capacity);
+  }
+  
+  arena->committed = committed;
+  arena->dirty = 0;
+  return 1;
+}
+
+void ReleaseArena(Arena *arena)
+{
+  ReleasePages(arena->data, arena->capacity);
+  memset(arena, 0, sizeof(Arena));
+}
+
 void Destroy(Arena *arena)
 {
-  memset(arena->data, 0, arena->capacity);
+  memset(arena->data, 0, arena->dirty);
+  arena->dirty = 0;
+  arena->cur = 0;
+  arena->prev = 0;
+}
+
+// Rewinds without clearing, Alloc still zeroes what gets handed out again
+void ResetArena(Arena *arena)
+{
   arena->cur = 0;
   arena->prev = 0;
 }
@@ -98,10 +209,161 @@ void TmpBegin(TmpArena *tmp, Arena *src)
   tmp->arena = src;
   tmp->prev = src->prev;
   tmp->cur = src->cur;
+  tmp->outerScopePeak = src->stats.scopePeak;
+  tmp->peak = 0;
+  src->stats.scopePeak = src->cur;
 }
 
 void TmpEnd(TmpArena *tmp)
 {
+  ArenaStats *stats = &tmp->arena->stats;
+  
+  // Bytes used by this scope at its highest, nested scopes included
+  tmp->peak = stats->scopePeak - tmp->cur;
+  if (tmp->peak > stats->tmpPeak) stats->tmpPeak = tmp->peak;
+  if (tmp->outerScopePeak > stats->scopePeak) stats->scopePeak = tmp->outerScopePeak;
+  
   tmp->arena->prev = tmp->prev;
   tmp->arena->cur = tmp->cur;
 }
+
+// The JSON report is a single object without a line break, callers embed it
+// in their own record
+void PrintArenaStats(FILE *stream, Arena *arena, const char *name, i32 json)
+{
+  ArenaStats *stats = &arena->stats;
+  
+  if (json)
+  {
+    fprintf(stream, "{\"arena\":\"%s\",\"peak\":%zu,\"committed\":%zu,\"capacity\":%zu,"
+                    "\"allocations\":%zu,\"padding\":%zu,\"tmpPeak\":%zu,\"hugePages\":%s}",
+            name, stats->peak, arena->committed, arena->capacity,
+            stats->allocCount, stats->paddingBytes, stats->tmpPeak, arena->hugePages ? "true" : "false");
+  }
+  else
+  {
+    fprintf(stream, "%s arena:\n", name);
+    fprintf(stream, "  peak        %zu bytes\n", stats->peak);
+    fprintf(stream, "  committed   %zu bytes\n", arena->committed);
+    fprintf(stream, "  capacity    %zu bytes\n", arena->capacity);
+    fprintf(stream, "  allocations %zu\n", stats->allocCount);
+    fprintf(stream, "  padding     %zu bytes\n", stats->paddingBytes);
+    fprintf(stream, "  tmp peak    %zu bytes\n", stats->tmpPeak);
+    fprintf(stream, "  huge pages  %s\n", arena->hugePages ? "yes" : "no");
+  }
+}
+
+// Scratch arenas, two per thread so a function can allocate its temporaries in
+// one while its result lives in the other (passed through conflicts).
+
+THREAD_LOCAL Arena scratchArenas[2];
+
+TmpArena GetScratch(Arena **conflicts, i32 conflictsCount)
+{
+  TmpArena tmp = {0};
+  
+  for (i32 i = 0; i < 2; ++i)
+  {
+    Arena *scratch = &scratchArenas[i];
+    i32 conflicting = 0;
+    
+    for (i32 j = 0; j < conflictsCount; ++j)
+    {
+      if (conflicts[j] == scratch) conflicting = 1;
+    }
+    
+    if (conflicting) continue;
+    if (!scratch->data && !ReserveArena(scratch, SCRATCH_ARENA_SIZE, 0)) break;
+    
+    TmpBegin(&tmp, scratch);
+    break;
+  }
+  
+  return tmp;
+}
+
+#define ReleaseScratch(tmp) TmpEnd(tmp)
+
+// Called by each thread before exiting, scratch arenas are reserved lazily
+void ReleaseScratchArenas(void)
+{
+  for (i32 i = 0; i < 2; ++i)
+  {
+    if (scratchArenas[i].data) ReleaseArena(&scratchArenas[i]);
+  }
+}
+
+// Fixed-size block pool, freed blocks are recycled through an intrusive free
+// list and new ones are carved from slabs bumped out of the backing arena.
+// A pool is not thread safe, give each worker its own on its scratch arena.
+
+typedef struct PoolBlock {
+  struct PoolBlock *next;
+} PoolBlock;
+
+typedef struct Pool {
+  size_t blockSize;
+  size_t blocksPerSlab;
+  PoolBlock *freeList;
+  uc *slabCur;
+  uc *slabEnd;
+  Arena *arena;
+} Pool;
+
+void InitPool(Pool *pool, Arena *arena, size_t blockSize, size_t blocksPerSlab)
+{
+  if (blockSize < sizeof(PoolBlock)) blockSize = sizeof(PoolBlock);
+  pool->blockSize = AlignForward(blockSize, DEFAULT_ALIGNMENT);
+  pool->blocksPerSlab = blocksPerSlab ? blocksPerSlab : 1;
+  pool->freeList = NULL;
+  pool->slabCur = NULL;
+  pool->slabEnd = NULL;
+  pool->arena = arena;
+}
+
+void *PoolAllocNoZero(Pool *pool)
+{
+  PoolBlock *block = pool->freeList;
+  
+  if (block)
+  {
+    pool->freeList = block->next;
+    return block;
+  }
+  
+  if (pool->slabCur == pool->slabEnd)
+  {
+    size_t slabSize = pool->blockSize * pool->blocksPerSlab;
+    uc *slab = (uc *)AllocNoZero(pool->arena, slabSize);
+    if (!slab) return NULL;
+    pool->slabCur = slab;
+    pool->slabEnd = slab + slabSize;
+  }
+  
+  void *ptr = pool->slabCur;
+  pool->slabCur += pool->blockSize;
+  return ptr;
+}
+
+void *PoolAlloc(Pool *pool)
+{
+  void *ptr = PoolAllocNoZero(pool);
+  if (ptr) memset(ptr, 0, pool->blockSize);
+  return ptr;
+}
+
+void PoolFree(Pool *pool, void *ptr)
+{
+  if (!ptr) return;
+  PoolBlock *block = (PoolBlock *)ptr;
+  block->next = pool->freeList;
+  pool->freeList = block;
+}
+
+// Forgets every block, the slabs themselves go away with the arena
+void ResetPool(Pool *pool)
+{
+  pool->freeList = NULL;
+  pool->slabCur = NULL;
+  pool->slabEnd = NULL;
+}
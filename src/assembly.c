@@ -0,0 +1,507 @@
+/*
+  Copyright (c) 2025 Alexandre Perché (@vegasword)
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include "immintrin.h"
+#define ASSEMBLY_X86
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include "arm_neon.h"
+#define ASSEMBLY_NEON
+#endif
+
+// Kernels for a given instruction set are compiled regardless of the build
+// flags, they only run once the CPU reported supporting it.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define TARGET_SSE41
+#define TARGET_AVX2
+#else
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// Vertex assembly, source attribute streams are read in lockstep and each
+// Vertex is written once. Missing streams read zeros, the boundaries of the
+// positions are accumulated along the way.
+
+#define ASSEMBLY_BLOCK_SIZE 64 // 64 * 18 bytes = 18 cache lines
+
+typedef struct VertexStreams {
+  uc *position, *normal, *tangent, *texcoord;
+  size_t positionStride, normalStride, tangentStride, texcoordStride;
+  VertexFormats *formats; // NULL when every stream is stored as in Vertex
+} VertexStreams;
+
+// Assembles vertices [begin, end), minBoundary and maxBoundary are accumulated
+typedef void (*AssemblyKernel)(Vertex *vertices, size_t begin, size_t end, VertexStreams *streams, u16 *minBoundary, u16 *maxBoundary);
+
+static uc zeroAttribute[8];
+
+void ResetBoundaries(u16 *minBoundary, u16 *maxBoundary)
+{
+  minBoundary[0] = minBoundary[1] = minBoundary[2] = UINT16_MAX;
+  maxBoundary[0] = maxBoundary[1] = maxBoundary[2] = 0;
+}
+
+void FillMissingStreams(VertexStreams *streams)
+{
+  if (!streams->position) streams->position = zeroAttribute, streams->positionStride = 0;
+  if (!streams->normal) streams->normal = zeroAttribute, streams->normalStride = 0;
+  if (!streams->tangent) streams->tangent = zeroAttribute, streams->tangentStride = 0;
+  if (!streams->texcoord) streams->texcoord = zeroAttribute, streams->texcoordStride = 0;
+}
+
+// Any layout, each Vertex is built in a block that is copied out whole
+void AssembleVertexRange(Vertex *vertices, size_t begin, size_t end, VertexStreams *streams, u16 *minBoundary, u16 *maxBoundary)
+{
+  // Built once so the padding byte copied out with each block stays zeroed
+  Vertex block[ASSEMBLY_BLOCK_SIZE] = {0};
+  
+  for (size_t first = begin; first < end; first += ASSEMBLY_BLOCK_SIZE)
+  {
+    size_t blockCount = MIN(ASSEMBLY_BLOCK_SIZE, end - first);
+    
+    for (size_t j = 0; j < blockCount; ++j)
+    {
+      size_t index = first + j;
+      u16 *position = (u16 *)(streams->position + index * streams->positionStride);
+      i8 *normal = (i8 *)(streams->normal + index * streams->normalStride);
+      i8 *tangent = (i8 *)(streams->tangent + index * streams->tangentStride);
+      u16 *texcoord = (u16 *)(streams->texcoord + index * streams->texcoordStride);
+      
+      Vertex *vertex = &block[j];
+      vertex->x = position[0];
+      vertex->y = position[1];
+      vertex->z = position[2];
+      vertex->nx = normal[0];
+      vertex->ny = normal[1];
+      vertex->nz = normal[2];
+      vertex->tx = tangent[0];
+      vertex->ty = tangent[1];
+      vertex->tz = tangent[2];
+      vertex->handedness = tangent[3];
+      vertex->u = texcoord[0];
+      vertex->v = texcoord[1];
+      
+      minBoundary[0] = MIN(minBoundary[0], vertex->x);
+      minBoundary[1] = MIN(minBoundary[1], vertex->y);
+      minBoundary[2] = MIN(minBoundary[2], vertex->z);
+      
+      maxBoundary[0] = MAX(maxBoundary[0], vertex->x);
+      maxBoundary[1] = MAX(maxBoundary[1], vertex->y);
+      maxBoundary[2] = MAX(maxBoundary[2], vertex->z);
+    }
+    
+    memcpy(vertices + first, block, blockCount * sizeof(Vertex));
+  }
+}
+
+// Streams stored in other formats, each attribute is decoded over the block
+// before it is copied out. Streams missing keep the Vertex formats and read zeros.
+void DecodeVertexRange(Vertex *vertices, size_t begin, size_t end, VertexStreams *streams, u16 *minBoundary, u16 *maxBoundary)
+{
+  Vertex block[ASSEMBLY_BLOCK_SIZE] = {0};
+  VertexFormats *formats = streams->formats;
+  
+  for (size_t first = begin; first < end; first += ASSEMBLY_BLOCK_SIZE)
+  {
+    size_t blockCount = MIN(ASSEMBLY_BLOCK_SIZE, end - first);
+    
+    formats->position.decode(block, blockCount, streams->position + first * streams->positionStride, streams->positionStride, &formats->position);
+    formats->normal.decode(block, blockCount, streams->normal + first * streams->normalStride, streams->normalStride, &formats->normal);
+    formats->tangent.decode(block, blockCount, streams->tangent + first * streams->tangentStride, streams->tangentStride, &formats->tangent);
+    formats->texcoord.decode(block, blockCount, streams->texcoord + first * streams->texcoordStride, streams->texcoordStride, &formats->texcoord);
+    
+    for (size_t j = 0; j < blockCount; ++j)
+    {
+      minBoundary[0] = MIN(minBoundary[0], block[j].x);
+      minBoundary[1] = MIN(minBoundary[1], block[j].y);
+      minBoundary[2] = MIN(minBoundary[2], block[j].z);
+      
+      maxBoundary[0] = MAX(maxBoundary[0], block[j].x);
+      maxBoundary[1] = MAX(maxBoundary[1], block[j].y);
+      maxBoundary[2] = MAX(maxBoundary[2], block[j].z);
+    }
+    
+    memcpy(vertices + first, block, blockCount * sizeof(Vertex));
+  }
+}
+
+// Packed kernels, for the layout gltfpack writes: 8 byte positions and 4 byte
+// normals, tangents and texcoords. Vertex records are shuffled out of
+// [position | normal tangent] pairs, texcoord u lands in the last two bytes of
+// the 16 byte record store and v is written next to it.
+//
+//   record  x y z | nx ny nz | tx ty tz h | 0 | u   (16 bytes) + v
+//
+// Positions are loaded 8 bytes at a time and normals 4, the caller keeps the
+// last vertex out of their range so these loads never go past a buffer view.
+
+#define PACKED_POSITION_STRIDE 8
+#define PACKED_ATTRIBUTE_STRIDE 4
+
+i32 IsPackedLayout(VertexStreams *streams)
+{
+  return streams->positionStride == PACKED_POSITION_STRIDE && streams->normalStride == PACKED_ATTRIBUTE_STRIDE &&
+         streams->tangentStride == PACKED_ATTRIBUTE_STRIDE && streams->texcoordStride == PACKED_ATTRIBUTE_STRIDE;
+}
+
+#if defined(ASSEMBLY_X86)
+
+TARGET_SSE41 static void AssemblePackedSse41(Vertex *vertices, size_t begin, size_t end, VertexStreams *streams, u16 *minBoundary, u16 *maxBoundary)
+{
+  const __m128i layout = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1);
+  const __m128i texcoordU[4] = {
+    _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 1),
+    _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, 5),
+    _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 8, 9),
+    _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 12, 13),
+  };
+  __m128i minPosition = _mm_set1_epi16(-1), maxPosition = _mm_setzero_si128();
+  
+  for (size_t i = begin; i < end; i += 4)
+  {
+    uc *dst = (uc *)(vertices + i);
+    __m128i p01 = _mm_loadu_si128((const __m128i *)(streams->position + i * PACKED_POSITION_STRIDE));
+    __m128i p23 = _mm_loadu_si128((const __m128i *)(streams->position + i * PACKED_POSITION_STRIDE + 16));
+    __m128i normals = _mm_loadu_si128((const __m128i *)(streams->normal + i * PACKED_ATTRIBUTE_STRIDE));
+    __m128i tangents = _mm_loadu_si128((const __m128i *)(streams->tangent + i * PACKED_ATTRIBUTE_STRIDE));
+    __m128i texcoords = _mm_loadu_si128((const __m128i *)(streams->texcoord + i * PACKED_ATTRIBUTE_STRIDE));
+    
+    __m128i nt01 = _mm_unpacklo_epi32(normals, tangents);
+    __m128i nt23 = _mm_unpackhi_epi32(normals, tangents);
+    __m128i records[4] = {
+      _mm_unpacklo_epi64(p01, nt01), _mm_unpackhi_epi64(p01, nt01),
+      _mm_unpacklo_epi64(p23, nt23), _mm_unpackhi_epi64(p23, nt23),
+    };
+    u16 v[4] = {
+      (u16)_mm_extract_epi16(texcoords, 1), (u16)_mm_extract_epi16(texcoords, 3),
+      (u16)_mm_extract_epi16(texcoords, 5), (u16)_mm_extract_epi16(texcoords, 7),
+    };
+    
+    for (i32 k = 0; k < 4; ++k)
+    {
+      __m128i record = _mm_or_si128(_mm_shuffle_epi8(records[k], layout), _mm_shuffle_epi8(texcoords, texcoordU[k]));
+      _mm_storeu_si128((__m128i *)(dst + k * sizeof(Vertex)), record);
+      memcpy(dst + k * sizeof(Vertex) + 16, &v[k], sizeof(u16));
+    }
+    
+    // w lanes are gathered too and ignored when reducing
+    minPosition = _mm_min_epu16(minPosition, _mm_min_epu16(p01, p23));
+    maxPosition = _mm_max_epu16(maxPosition, _mm_max_epu16(p01, p23));
+  }
+  
+  minPosition = _mm_min_epu16(minPosition, _mm_srli_si128(minPosition, 8));
+  maxPosition = _mm_max_epu16(maxPosition, _mm_srli_si128(maxPosition, 8));
+  
+  minBoundary[0] = MIN(minBoundary[0], (u16)_mm_extract_epi16(minPosition, 0));
+  minBoundary[1] = MIN(minBoundary[1], (u16)_mm_extract_epi16(minPosition, 1));
+  minBoundary[2] = MIN(minBoundary[2], (u16)_mm_extract_epi16(minPosition, 2));
+  maxBoundary[0] = MAX(maxBoundary[0], (u16)_mm_extract_epi16(maxPosition, 0));
+  maxBoundary[1] = MAX(maxBoundary[1], (u16)_mm_extract_epi16(maxPosition, 1));
+  maxBoundary[2] = MAX(maxBoundary[2], (u16)_mm_extract_epi16(maxPosition, 2));
+}
+
+// Same shuffles on two vertices per register, lane 0 holds vertex k and lane 1 vertex k + 4
+TARGET_AVX2 static void AssemblePackedAvx2(Vertex *vertices, size_t begin, size_t end, VertexStreams *streams, u16 *minBoundary, u16 *maxBoundary)
+{
+  const __m256i layout = _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1,
+                                          0, 1, 2, 3, 4, 5, 8, 9, 10, 12, 13, 14, 15, -1, -1, -1);
+  __m256i texcoordU[4];
+  __m256i minPosition = _mm256_set1_epi16(-1), maxPosition = _mm256_setzero_si256();
+  
+  for (i32 k = 0; k < 4; ++k)
+  {
+    texcoordU[k] = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(4 * k), (char)(4 * k + 1),
+                                    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(4 * k), (char)(4 * k + 1));
+  }
+  
+  for (size_t i = begin; i < end; i += 8)
+  {
+    uc *dst = (uc *)(vertices + i);
+    const uc *positions = streams->position + i * PACKED_POSITION_STRIDE;
+    __m256i p01p45 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)positions)),
+                                             _mm_loadu_si128((const __m128i *)(positions + 32)), 1);
+    __m256i p23p67 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(positions + 16))),
+                                             _mm_loadu_si128((const __m128i *)(positions + 48)), 1);
+    __m256i normals = _mm256_loadu_si256((const __m256i *)(streams->normal + i * PACKED_ATTRIBUTE_STRIDE));
+    __m256i tangents = _mm256_loadu_si256((const __m256i *)(streams->tangent + i * PACKED_ATTRIBUTE_STRIDE));
+    __m256i texcoords = _mm256_loadu_si256((const __m256i *)(streams->texcoord + i * PACKED_ATTRIBUTE_STRIDE));
+    
+    __m256i nt01nt45 = _mm256_unpacklo_epi32(normals, tangents);
+    __m256i nt23nt67 = _mm256_unpackhi_epi32(normals, tangents);
+    __m256i records[4] = {
+      _mm256_unpacklo_epi64(p01p45, nt01nt45), _mm256_unpackhi_epi64(p01p45, nt01nt45),
+      _mm256_unpacklo_epi64(p23p67, nt23nt67), _mm256_unpackhi_epi64(p23p67, nt23nt67),
+    };
+    u16 v[8];
+    for (i32 k = 0; k < 8; ++k) memcpy(&v[k], streams->texcoord + (i + k) * PACKED_ATTRIBUTE_STRIDE + 2, sizeof(u16));
+    
+    for (i32 k = 0; k < 4; ++k)
+    {
+      __m256i record = _mm256_or_si256(_mm256_shuffle_epi8(records[k], layout), _mm256_shuffle_epi8(texcoords, texcoordU[k]));
+      _mm_storeu_si128((__m128i *)(dst + k * sizeof(Vertex)), _mm256_castsi256_si128(record));
+      _mm_storeu_si128((__m128i *)(dst + (k + 4) * sizeof(Vertex)), _mm256_extracti128_si256(record, 1));
+      memcpy(dst + k * sizeof(Vertex) + 16, &v[k], sizeof(u16));
+      memcpy(dst + (k + 4) * sizeof(Vertex) + 16, &v[k + 4], sizeof(u16));
+    }
+    
+    minPosition = _mm256_min_epu16(minPosition, _mm256_min_epu16(p01p45, p23p67));
+    maxPosition = _mm256_max_epu16(maxPosition, _mm256_max_epu16(p01p45, p23p67));
+  }
+  
+  __m128i minHalf = _mm_min_epu16(_mm256_castsi256_si128(minPosition), _mm256_extracti128_si256(minPosition, 1));
+  __m128i maxHalf = _mm_max_epu16(_mm256_castsi256_si128(maxPosition), _mm256_extracti128_si256(maxPosition, 1));
+  minHalf = _mm_min_epu16(minHalf, _mm_srli_si128(minHalf, 8));
+  maxHalf = _mm_max_epu16(maxHalf, _mm_srli_si128(maxHalf, 8));
+  
+  minBoundary[0] = MIN(minBoundary[0], (u16)_mm_extract_epi16(minHalf, 0));
+  minBoundary[1] = MIN(minBoundary[1], (u16)_mm_extract_epi16(minHalf, 1));
+  minBoundary[2] = MIN(minBoundary[2], (u16)_mm_extract_epi16(minHalf, 2));
+  maxBoundary[0] = MAX(maxBoundary[0], (u16)_mm_extract_epi16(maxHalf, 0));
+  maxBoundary[1] = MAX(maxBoundary[1], (u16)_mm_extract_epi16(maxHalf, 1));
+  maxBoundary[2] = MAX(maxBoundary[2], (u16)_mm_extract_epi16(maxHalf, 2));
+}
+
+#elif defined(ASSEMBLY_NEON)
+
+static void AssemblePackedNeon(Vertex *vertices, size_t begin, size_t end, VertexStreams *streams, u16 *minBoundary, u16 *maxBoundary)
+{
+  static const uint8_t layoutIndices[16] = { 0, 1, 2, 3, 4, 5, 8, 9, 10, 12, 13, 14, 15, 0xFF, 0xFF, 0xFF };
+  static const uint8_t texcoordIndices[4][16] = {
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0, 1 },
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 4, 5 },
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 8, 9 },
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 12, 13 },
+  };
+  const uint8x16_t layout = vld1q_u8(layoutIndices);
+  uint16x8_t minPosition = vdupq_n_u16(UINT16_MAX), maxPosition = vdupq_n_u16(0);
+  
+  for (size_t i = begin; i < end; i += 4)
+  {
+    uc *dst = (uc *)(vertices + i);
+    uint8x16_t p01 = vld1q_u8(streams->position + i * PACKED_POSITION_STRIDE);
+    uint8x16_t p23 = vld1q_u8(streams->position + i * PACKED_POSITION_STRIDE + 16);
+    uint32x4_t normals = vreinterpretq_u32_u8(vld1q_u8(streams->normal + i * PACKED_ATTRIBUTE_STRIDE));
+    uint32x4_t tangents = vreinterpretq_u32_u8(vld1q_u8(streams->tangent + i * PACKED_ATTRIBUTE_STRIDE));
+    uint8x16_t texcoords = vld1q_u8(streams->texcoord + i * PACKED_ATTRIBUTE_STRIDE);
+    
+    uint8x16_t nt01 = vreinterpretq_u8_u32(vzip1q_u32(normals, tangents));
+    uint8x16_t nt23 = vreinterpretq_u8_u32(vzip2q_u32(normals, tangents));
+    uint8x16_t records[4] = {
+      vcombine_u8(vget_low_u8(p01), vget_low_u8(nt01)), vcombine_u8(vget_high_u8(p01), vget_high_u8(nt01)),
+      vcombine_u8(vget_low_u8(p23), vget_low_u8(nt23)), vcombine_u8(vget_high_u8(p23), vget_high_u8(nt23)),
+    };
+    
+    for (i32 k = 0; k < 4; ++k)
+    {
+      uint8x16_t record = vorrq_u8(vqtbl1q_u8(records[k], layout), vqtbl1q_u8(texcoords, vld1q_u8(texcoordIndices[k])));
+      vst1q_u8(dst + k * sizeof(Vertex), record);
+      memcpy(dst + k * sizeof(Vertex) + 16, streams->texcoord + (i + k) * PACKED_ATTRIBUTE_STRIDE + 2, sizeof(u16));
+    }
+    
+    uint16x8_t p01Lanes = vreinterpretq_u16_u8(p01), p23Lanes = vreinterpretq_u16_u8(p23);
+    minPosition = vminq_u16(minPosition, vminq_u16(p01Lanes, p23Lanes));
+    maxPosition = vmaxq_u16(maxPosition, vmaxq_u16(p01Lanes, p23Lanes));
+  }
+  
+  uint16x4_t minHalf = vmin_u16(vget_low_u16(minPosition), vget_high_u16(minPosition));
+  uint16x4_t maxHalf = vmax_u16(vget_low_u16(maxPosition), vget_high_u16(maxPosition));
+  
+  minBoundary[0] = MIN(minBoundary[0], vget_lane_u16(minHalf, 0));
+  minBoundary[1] = MIN(minBoundary[1], vget_lane_u16(minHalf, 1));
+  minBoundary[2] = MIN(minBoundary[2], vget_lane_u16(minHalf, 2));
+  maxBoundary[0] = MAX(maxBoundary[0], vget_lane_u16(maxHalf, 0));
+  maxBoundary[1] = MAX(maxBoundary[1], vget_lane_u16(maxHalf, 1));
+  maxBoundary[2] = MAX(maxBoundary[2], vget_lane_u16(maxHalf, 2));
+}
+
+#endif
+
+// Kernel selection
+
+typedef struct AssemblyKernelInfo {
+  AssemblyKernel kernel;
+  size_t width;
+  const char *name;
+} AssemblyKernelInfo;
+
+static AssemblyKernelInfo packedKernel;
+
+// Picks the packed kernel for this CPU once, NULL kernel when none applies
+AssemblyKernelInfo *SelectAssemblyKernel(void)
+{
+  if (packedKernel.name) return &packedKernel;
+  
+  packedKernel.name = "scalar";
+  
+#if defined(ASSEMBLY_X86)
+  CpuFeatures features = GetCpuFeatures();
+  if (features.avx2)
+  {
+    packedKernel.kernel = AssemblePackedAvx2;
+    packedKernel.width = 8;
+    packedKernel.name = "avx2";
+  }
+  else if (features.sse41)
+  {
+    packedKernel.kernel = AssemblePackedSse41;
+    packedKernel.width = 4;
+    packedKernel.name = "sse4.1";
+  }
+#elif defined(ASSEMBLY_NEON)
+  packedKernel.kernel = AssemblePackedNeon;
+  packedKernel.width = 4;
+  packedKernel.name = "neon";
+#endif
+  
+  return &packedKernel;
+}
+
+// Packed streams go through the vector kernel, the remainder (always including
+// the last vertex) and any other layout through AssembleVertexRange. Streams in
+// other formats than Vertex are decoded instead.
+void AssembleVertices(Vertex *vertices, size_t begin, size_t end, VertexStreams *streams, u16 *minBoundary, u16 *maxBoundary)
+{
+  AssemblyKernelInfo *info = SelectAssemblyKernel();
+  size_t kernelEnd = begin;
+  
+  if (streams->formats)
+  {
+    DecodeVertexRange(vertices, begin, end, streams, minBoundary, maxBoundary);
+    return;
+  }
+  
+  if (info->kernel && IsPackedLayout(streams) && end > begin)
+  {
+    kernelEnd = begin + (end - 1 - begin) / info->width * info->width;
+    info->kernel(vertices, begin, kernelEnd, streams, minBoundary, maxBoundary);
+  }
+  
+  AssembleVertexRange(vertices, kernelEnd, end, streams, minBoundary, maxBoundary);
+}
+
+// Vertex ranges split in chunks assembled on workers, each chunk accumulates
+// its own boundaries which are merged once every chunk is done.
+
+#define ASSEMBLY_CHUNK_SIZE (64 * 1024)
+
+typedef struct AssemblyJob {
+  Vertex *vertices;
+  size_t count;
+  VertexStreams *streams;
+  u16 *minBoundaries;
+  u16 *maxBoundaries;
+} AssemblyJob;
+
+static i32 AssembleChunks(void *data, size_t begin, size_t end)
+{
+  AssemblyJob *job = (AssemblyJob *)data;
+  
+  for (size_t chunk = begin; chunk < end; ++chunk)
+  {
+    size_t first = chunk * ASSEMBLY_CHUNK_SIZE;
+    size_t last = MIN(first + ASSEMBLY_CHUNK_SIZE, job->count);
+    u16 *minBoundary = job->minBoundaries + chunk * 3;
+    u16 *maxBoundary = job->maxBoundaries + chunk * 3;
+    
+    ResetBoundaries(minBoundary, maxBoundary);
+    AssembleVertices(job->vertices, first, last, job->streams, minBoundary, maxBoundary);
+  }
+  
+  return 0;
+}
+
+i32 AssembleVerticesParallel(WorkerPool *workers, Arena *arena, Vertex *vertices, size_t count, VertexStreams *streams, u16 *minBoundary, u16 *maxBoundary)
+{
+  size_t chunksCount = (count + ASSEMBLY_CHUNK_SIZE - 1) / ASSEMBLY_CHUNK_SIZE;
+  TmpArena tmp = {0};
+  TmpBegin(&tmp, arena);
+  
+  u16 *minBoundaries = (u16 *)AllocNoZero(arena, chunksCount * 3 * sizeof(u16));
+  u16 *maxBoundaries = (u16 *)AllocNoZero(arena, chunksCount * 3 * sizeof(u16));
+  AssemblyJob job = { vertices, count, streams, minBoundaries, maxBoundaries };
+  
+  // Selected up front, workers would otherwise race on the lazy selection
+  SelectAssemblyKernel();
+  i32 result = ParallelFor(workers, chunksCount, AssembleChunks, &job);
+  
+  for (size_t chunk = 0; chunk < chunksCount && result == 0; ++chunk)
+  {
+    for (i32 k = 0; k < 3; ++k)
+    {
+      minBoundary[k] = MIN(minBoundary[k], minBoundaries[chunk * 3 + k]);
+      maxBoundary[k] = MAX(maxBoundary[k], maxBoundaries[chunk * 3 + k]);
+    }
+  }
+  
+  TmpEnd(&tmp);
+  return result;
+}
+
+// Previous structure, one pass over the destination per attribute. Only kept
+// as the baseline of --bench, vertices must be zeroed beforehand.
+// Boundaries are accumulated like the other assembly paths.
+void AssembleVerticesPerAttribute(Vertex *vertices, u32 count, VertexStreams *streams, u16 *minBoundary, u16 *maxBoundary)
+{
+  for (u32 j = 0; j < count; ++j)
+  {
+    u16 *position = (u16 *)(streams->position + (size_t)j * streams->positionStride);
+    Vertex *vertex = &vertices[j];
+    vertex->x = position[0];
+    vertex->y = position[1];
+    vertex->z = position[2];
+    
+    minBoundary[0] = MIN(minBoundary[0], vertex->x);
+    minBoundary[1] = MIN(minBoundary[1], vertex->y);
+    minBoundary[2] = MIN(minBoundary[2], vertex->z);
+    
+    maxBoundary[0] = MAX(maxBoundary[0], vertex->x);
+    maxBoundary[1] = MAX(maxBoundary[1], vertex->y);
+    maxBoundary[2] = MAX(maxBoundary[2], vertex->z);
+  }
+  
+  for (u32 j = 0; j < count; ++j)
+  {
+    i8 *normal = (i8 *)(streams->normal + (size_t)j * streams->normalStride);
+    Vertex *vertex = &vertices[j];
+    vertex->nx = normal[0];
+    vertex->ny = normal[1];
+    vertex->nz = normal[2];
+  }
+  
+  for (u32 j = 0; j < count; ++j)
+  {
+    i8 *tangent = (i8 *)(streams->tangent + (size_t)j * streams->tangentStride);
+    Vertex *vertex = &vertices[j];
+    vertex->tx = tangent[0];
+    vertex->ty = tangent[1];
+    vertex->tz = tangent[2];
+    vertex->handedness = tangent[3];
+  }
+  
+  for (u32 j = 0; j < count; ++j)
+  {
+    u16 *texcoord = (u16 *)(streams->texcoord + (size_t)j * streams->texcoordStride);
+    Vertex *vertex = &vertices[j];
+    vertex->u = texcoord[0];
+    vertex->v = texcoord[1];
+  }
+}
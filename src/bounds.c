@@ -0,0 +1,298 @@
+/*
+  Copyright (c) 2025 Alexandre Perché (@vegasword)
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Bounding sphere of the assembled vertices, built with Ritter's method: a
+// first diameter between two far apart vertices, then grown towards the
+// farthest vertex until every vertex is inside. Each step is a farthest vertex
+// search over every vertex. Distances are squared and compared in the
+// quantized position space.
+//
+// The output header has no room for it, it's only reported by --stats (and
+// --stats=json) to check how well the quantized boundaries fit a model.
+
+// Passes growing the sphere towards its farthest vertex before settling, the
+// final radius always reaches the farthest vertex of the last center
+#define SPHERE_GROW_PASSES 8
+
+// Returns the greatest squared distance of vertices [begin, end) to center and
+// the index of that vertex, -1 for an empty range
+typedef f32 (*SphereKernel)(Vertex *vertices, size_t begin, size_t end, f32 *center, size_t *farthestIndex);
+
+f32 FarthestVertexRange(Vertex *vertices, size_t begin, size_t end, f32 *center, size_t *farthestIndex)
+{
+  f32 farthest = -1.0f;
+  
+  for (size_t j = begin; j < end; ++j)
+  {
+    Vertex *vertex = &vertices[j];
+    f32 dx = (f32)vertex->x - center[0];
+    f32 dy = (f32)vertex->y - center[1];
+    f32 dz = (f32)vertex->z - center[2];
+    f32 distance = dx * dx + dy * dy + dz * dz;
+    if (distance > farthest) farthest = distance, *farthestIndex = j;
+  }
+  
+  return farthest;
+}
+
+// Lanes of a SIMD kernel, the first greatest distance wins like in the scalar loop
+static f32 FarthestLane(f32 *distances, u32 *indices, i32 width, size_t *farthestIndex)
+{
+  f32 farthest = -1.0f;
+  
+  for (i32 k = 0; k < width; ++k)
+  {
+    if (distances[k] > farthest || (distances[k] == farthest && indices[k] < *farthestIndex))
+    {
+      farthest = distances[k];
+      *farthestIndex = indices[k];
+    }
+  }
+  
+  return farthest;
+}
+#if defined(ASSEMBLY_X86)
+
+// The first 8 bytes of 4 vertices (x, y, z, nx) widened to floats then
+// transposed into x, y, z lanes.
+TARGET_SSE41 static f32 FarthestVertexSse41(Vertex *vertices, size_t begin, size_t end, f32 *center, size_t *farthestIndex)
+{
+  __m128 centerX = _mm_set1_ps(center[0]);
+  __m128 centerY = _mm_set1_ps(center[1]);
+  __m128 centerZ = _mm_set1_ps(center[2]);
+  __m128 farthest = _mm_set1_ps(-1.0f);
+  __m128i index = _mm_add_epi32(_mm_set1_epi32((i32)begin), _mm_setr_epi32(0, 1, 2, 3));
+  __m128i farthestLanes = index;
+  
+  for (size_t j = begin; j < end; j += 4)
+  {
+    __m128 p0 = _mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i *)&vertices[j + 0])));
+    __m128 p1 = _mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i *)&vertices[j + 1])));
+    __m128 p2 = _mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i *)&vertices[j + 2])));
+    __m128 p3 = _mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_loadl_epi64((__m128i *)&vertices[j + 3])));
+    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+    
+    __m128 dx = _mm_sub_ps(p0, centerX);
+    __m128 dy = _mm_sub_ps(p1, centerY);
+    __m128 dz = _mm_sub_ps(p2, centerZ);
+    __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+    __m128 greater = _mm_cmpgt_ps(distance, farthest);
+    farthest = _mm_blendv_ps(farthest, distance, greater);
+    farthestLanes = _mm_blendv_epi8(farthestLanes, index, _mm_castps_si128(greater));
+    index = _mm_add_epi32(index, _mm_set1_epi32(4));
+  }
+  
+  f32 distances[4];
+  u32 indices[4];
+  _mm_storeu_ps(distances, farthest);
+  _mm_storeu_si128((__m128i *)indices, farthestLanes);
+  return FarthestLane(distances, indices, 4, farthestIndex);
+}
+
+// 8 vertices per step, x|y and z|nx pairs gathered at the Vertex stride
+TARGET_AVX2 static f32 FarthestVertexAvx2(Vertex *vertices, size_t begin, size_t end, f32 *center, size_t *farthestIndex)
+{
+  const __m256i offsets = _mm256_setr_epi32(0, 1 * sizeof(Vertex), 2 * sizeof(Vertex), 3 * sizeof(Vertex),
+                                            4 * sizeof(Vertex), 5 * sizeof(Vertex), 6 * sizeof(Vertex), 7 * sizeof(Vertex));
+  const __m256i lowMask = _mm256_set1_epi32(0xFFFF);
+  __m256 centerX = _mm256_set1_ps(center[0]);
+  __m256 centerY = _mm256_set1_ps(center[1]);
+  __m256 centerZ = _mm256_set1_ps(center[2]);
+  __m256 farthest = _mm256_set1_ps(-1.0f);
+  __m256i index = _mm256_add_epi32(_mm256_set1_epi32((i32)begin), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+  __m256i farthestLanes = index;
+  
+  for (size_t j = begin; j < end; j += 8)
+  {
+    __m256i xy = _mm256_i32gather_epi32((const int *)&vertices[j].x, offsets, 1);
+    __m256i zn = _mm256_i32gather_epi32((const int *)&vertices[j].z, offsets, 1);
+    
+    __m256 dx = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_and_si256(xy, lowMask)), centerX);
+    __m256 dy = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(xy, 16)), centerY);
+    __m256 dz = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_and_si256(zn, lowMask)), centerZ);
+    __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+    __m256 greater = _mm256_cmp_ps(distance, farthest, _CMP_GT_OQ);
+    farthest = _mm256_blendv_ps(farthest, distance, greater);
+    farthestLanes = _mm256_blendv_epi8(farthestLanes, index, _mm256_castps_si256(greater));
+    index = _mm256_add_epi32(index, _mm256_set1_epi32(8));
+  }
+  
+  f32 distances[8];
+  u32 indices[8];
+  _mm256_storeu_ps(distances, farthest);
+  _mm256_storeu_si256((__m256i *)indices, farthestLanes);
+  return FarthestLane(distances, indices, 8, farthestIndex);
+}
+
+#elif defined(ASSEMBLY_NEON)
+
+static f32 FarthestVertexNeon(Vertex *vertices, size_t begin, size_t end, f32 *center, size_t *farthestIndex)
+{
+  static const u32 laneOffsets[4] = {0, 1, 2, 3};
+  float32x4_t centerX = vdupq_n_f32(center[0]);
+  float32x4_t centerY = vdupq_n_f32(center[1]);
+  float32x4_t centerZ = vdupq_n_f32(center[2]);
+  float32x4_t farthest = vdupq_n_f32(-1.0f);
+  uint32x4_t index = vaddq_u32(vdupq_n_u32((u32)begin), vld1q_u32(laneOffsets));
+  uint32x4_t farthestLanes = index;
+  
+  for (size_t j = begin; j < end; j += 4)
+  {
+    float32x4_t p0 = vcvtq_f32_u32(vmovl_u16(vld1_u16(&vertices[j + 0].x)));
+    float32x4_t p1 = vcvtq_f32_u32(vmovl_u16(vld1_u16(&vertices[j + 1].x)));
+    float32x4_t p2 = vcvtq_f32_u32(vmovl_u16(vld1_u16(&vertices[j + 2].x)));
+    float32x4_t p3 = vcvtq_f32_u32(vmovl_u16(vld1_u16(&vertices[j + 3].x)));
+    
+    // (x0 x1 z0 z1) (y0 y1 . .) and (x2 x3 z2 z3) (y2 y3 . .)
+    float32x4x2_t p01 = vtrnq_f32(p0, p1);
+    float32x4x2_t p23 = vtrnq_f32(p2, p3);
+    
+    float32x4_t dx = vsubq_f32(vcombine_f32(vget_low_f32(p01.val[0]), vget_low_f32(p23.val[0])), centerX);
+    float32x4_t dy = vsubq_f32(vcombine_f32(vget_low_f32(p01.val[1]), vget_low_f32(p23.val[1])), centerY);
+    float32x4_t dz = vsubq_f32(vcombine_f32(vget_high_f32(p01.val[0]), vget_high_f32(p23.val[0])), centerZ);
+    float32x4_t distance = vaddq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)), vmulq_f32(dz, dz));
+    uint32x4_t greater = vcgtq_f32(distance, farthest);
+    farthest = vbslq_f32(greater, distance, farthest);
+    farthestLanes = vbslq_u32(greater, index, farthestLanes);
+    index = vaddq_u32(index, vdupq_n_u32(4));
+  }
+  
+  f32 distances[4];
+  u32 indices[4];
+  vst1q_f32(distances, farthest);
+  vst1q_u32(indices, farthestLanes);
+  return FarthestLane(distances, indices, 4, farthestIndex);
+}
+
+#endif
+
+typedef struct SphereKernelInfo {
+  SphereKernel kernel;
+  size_t width;
+  const char *name;
+} SphereKernelInfo;
+
+static SphereKernelInfo sphereKernel;
+
+// Same CPU checks as SelectAssemblyKernel, NULL kernel when none applies
+SphereKernelInfo *SelectSphereKernel(void)
+{
+  if (sphereKernel.name) return &sphereKernel;
+  
+  sphereKernel.name = "scalar";
+  
+#if defined(ASSEMBLY_X86)
+  CpuFeatures features = GetCpuFeatures();
+  if (features.avx2)
+  {
+    sphereKernel.kernel = FarthestVertexAvx2;
+    sphereKernel.width = 8;
+    sphereKernel.name = "avx2";
+  }
+  else if (features.sse41)
+  {
+    sphereKernel.kernel = FarthestVertexSse41;
+    sphereKernel.width = 4;
+    sphereKernel.name = "sse4.1";
+  }
+#elif defined(ASSEMBLY_NEON)
+  sphereKernel.kernel = FarthestVertexNeon;
+  sphereKernel.width = 4;
+  sphereKernel.name = "neon";
+#endif
+  
+  return &sphereKernel;
+}
+
+// Farthest vertex of the whole range, the kernel runs on full widths and the
+// scalar loop on what remains
+static f32 FarthestVertex(Vertex *vertices, size_t count, f32 *center, size_t *farthestIndex)
+{
+  SphereKernelInfo *info = SelectSphereKernel();
+  size_t kernelEnd = 0, tailIndex = 0;
+  f32 farthest = -1.0f;
+  
+  if (info->kernel)
+  {
+    kernelEnd = count / info->width * info->width;
+    if (kernelEnd) farthest = info->kernel(vertices, 0, kernelEnd, center, farthestIndex);
+  }
+  
+  f32 tail = FarthestVertexRange(vertices, kernelEnd, count, center, &tailIndex);
+  if (tail > farthest) farthest = tail, *farthestIndex = tailIndex;
+  return farthest;
+}
+
+static void VertexPosition(Vertex *vertex, f32 *position)
+{
+  position[0] = (f32)vertex->x;
+  position[1] = (f32)vertex->y;
+  position[2] = (f32)vertex->z;
+}
+
+// Ritter's sphere, kept only when tighter than the one centered on the
+// boundaries accumulated during assembly
+void ComputeBoundingSphere(Vertex *vertices, size_t count, u16 *minBoundary, u16 *maxBoundary, f32 *center, f32 *radius)
+{
+  f32 first[3], second[3];
+  size_t index = 0;
+  
+  center[0] = ((f32)minBoundary[0] + (f32)maxBoundary[0]) * 0.5f;
+  center[1] = ((f32)minBoundary[1] + (f32)maxBoundary[1]) * 0.5f;
+  center[2] = ((f32)minBoundary[2] + (f32)maxBoundary[2]) * 0.5f;
+  *radius = 0.0f;
+  if (!count) return;
+  
+  f32 boxFarthest = FarthestVertex(vertices, count, center, &index);
+  
+  // First diameter, from the vertex farthest of the box center to the one farthest of it
+  VertexPosition(&vertices[index], first);
+  FarthestVertex(vertices, count, first, &index);
+  VertexPosition(&vertices[index], second);
+  
+  f32 ritter[3], ritterRadius = 0.0f;
+  for (i32 k = 0; k < 3; ++k)
+  {
+    ritter[k] = (first[k] + second[k]) * 0.5f;
+    ritterRadius += (second[k] - first[k]) * (second[k] - first[k]);
+  }
+  ritterRadius = sqrtf(ritterRadius) * 0.5f;
+  
+  // Growing just enough to reach the farthest vertex, the opposite side stays put
+  f32 farthest = FarthestVertex(vertices, count, ritter, &index);
+  for (i32 pass = 0; pass < SPHERE_GROW_PASSES && farthest > ritterRadius * ritterRadius; ++pass)
+  {
+    f32 outside[3];
+    f32 distance = sqrtf(farthest);
+    f32 grown = (ritterRadius + distance) * 0.5f;
+    VertexPosition(&vertices[index], outside);
+    for (i32 k = 0; k < 3; ++k) ritter[k] += (outside[k] - ritter[k]) * (grown - ritterRadius) / distance;
+    ritterRadius = grown;
+    farthest = FarthestVertex(vertices, count, ritter, &index);
+  }
+  
+  if (farthest < boxFarthest)
+  {
+    memcpy(center, ritter, sizeof(ritter));
+    boxFarthest = farthest;
+  }
+  
+  *radius = sqrtf(boxFarthest);
+}
@@ -0,0 +1,409 @@
+/*
+  Copyright (c) 2025 Alexandre Perché (@vegasword)
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+// Parsed scene cache
+//
+// Keeps the part of cgltf_data the conversion reads (asset generator, meshes,
+// accessors, buffer views, buffers and materials) in a file named after a hash
+// of the input JSON. The cached structs are laid out contiguously, pointers
+// between them are stored as file offsets and listed in a relocation table so
+// loading is a single copy-on-write mapping plus one pass rebasing them.
+
+#define SCENE_CACHE_MAGIC 0x43433247 // "G2CC"
+#define SCENE_CACHE_VERSION 1
+
+typedef struct SceneCacheHeader {
+  u32 magic;
+  u32 version;
+  u64 layout;
+  u64 hash;
+  u64 jsonSize;
+  u64 checksum; // of everything after the header, before relocation
+  u64 binOffset;
+  u64 binSize;
+  u64 relocsOffset;
+  u64 relocsCount;
+} SceneCacheHeader;
+
+typedef struct SceneCacheKey {
+  u64 hash;
+  u64 jsonSize;
+  char *path;
+} SceneCacheKey;
+
+typedef struct SceneCacheWriter {
+  Arena *blob;
+  uc *base;
+  u64 *relocs;
+  u64 relocsCount;
+} SceneCacheWriter;
+
+static u64 RotateLeft(u64 x, i32 bits)
+{
+  return (x << bits) | (x >> (64 - bits));
+}
+
+// Not cryptographic, four independent multiply-rotate lanes over 32 byte
+// blocks so hashing the JSON stays far below the cost of parsing it.
+u64 HashBytes(const uc *bytes, u64 size)
+{
+  const u64 prime = 0x9E3779B97F4A7C15ULL;
+  u64 lanes[4] = { size, size ^ prime, RotateLeft(size, 17), ~size };
+  u64 i = 0;
+  
+  for (; i + 32 <= size; i += 32)
+  {
+    for (i32 j = 0; j < 4; ++j)
+    {
+      u64 word;
+      memcpy(&word, bytes + i + j * 8, 8);
+      lanes[j] = RotateLeft((lanes[j] ^ word) * prime, 31);
+    }
+  }
+  
+  uc tail[32] = {0};
+  memcpy(tail, bytes + i, size - i);
+  for (i32 j = 0; j < 4; ++j)
+  {
+    u64 word;
+    memcpy(&word, tail + j * 8, 8);
+    lanes[j] = RotateLeft((lanes[j] ^ word) * prime, 31);
+  }
+  
+  u64 hash = lanes[0] ^ RotateLeft(lanes[1], 16) ^ RotateLeft(lanes[2], 32) ^ RotateLeft(lanes[3], 48);
+  hash = (hash ^ (hash >> 33)) * 0xFF51AFD7ED558CCDULL;
+  hash = (hash ^ (hash >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+  return hash ^ (hash >> 33);
+}
+
+// Cached structs are raw cgltf structs, any change to their layout invalidates the cache
+static u64 SceneCacheLayout(void)
+{
+  u64 sizes[] = {
+    sizeof(void *), sizeof(cgltf_data), sizeof(cgltf_mesh), sizeof(cgltf_primitive), sizeof(cgltf_attribute),
+    sizeof(cgltf_accessor), sizeof(cgltf_buffer_view), sizeof(cgltf_buffer), sizeof(cgltf_material),
+  };
+  return HashBytes((const uc *)sizes, sizeof(sizes));
+}
+
+// Only the JSON chunk of a GLB is hashed, the binary chunk is read from the input as usual
+static const uc *SceneJson(MappedFile *input, u64 *size)
+{
+  u32 length;
+  
+  if (input->size >= 20 && memcmp(input->data, "glTF", 4) == 0)
+  {
+    memcpy(&length, input->data + 12, sizeof(u32));
+    if (20 + (u64)length <= input->size)
+    {
+      *size = length;
+      return input->data + 20;
+    }
+  }
+  
+  *size = input->size;
+  return input->data;
+}
+
+SceneCacheKey GetSceneCacheKey(Arena *arena, const char *directory, MappedFile *input)
+{
+  SceneCacheKey key = {0};
+  const uc *json = SceneJson(input, &key.jsonSize);
+  size_t pathSize = strlen(directory) + 32;
+  
+  key.hash = HashBytes(json, key.jsonSize);
+  key.path = (char *)AllocNoZero(arena, pathSize);
+  snprintf(key.path, pathSize, "%s/%016llx.g2c", directory, (unsigned long long)key.hash);
+  return key;
+}
+
+// Loading
+
+// Checks the header against the current input then rebases every pointer slot,
+// which along with the offset it holds must stay within the cached structs.
+static i32 RelocateSceneCache(MappedFile *file, SceneCacheKey *key, MappedFile *input, SceneCacheHeader *header)
+{
+  if (file->size < sizeof(SceneCacheHeader)) return 0;
+  
+  memcpy(header, file->data, sizeof(SceneCacheHeader));
+  if (header->magic != SCENE_CACHE_MAGIC || header->version != SCENE_CACHE_VERSION) return 0;
+  if (header->layout != SceneCacheLayout() || header->hash != key->hash || header->jsonSize != key->jsonSize) return 0;
+  if (header->relocsOffset < sizeof(SceneCacheHeader) + sizeof(cgltf_data) || header->relocsOffset % sizeof(u64)) return 0;
+  if (header->relocsOffset > file->size || header->relocsCount > (file->size - header->relocsOffset) / sizeof(u64)) return 0;
+  if (header->binOffset > input->size || header->binSize > input->size - header->binOffset) return 0;
+  if (HashBytes(file->data + sizeof(SceneCacheHeader), file->size - sizeof(SceneCacheHeader)) != header->checksum) return 0;
+  
+  u64 *relocs = (u64 *)(file->data + header->relocsOffset);
+  for (u64 i = 0; i < header->relocsCount; ++i)
+  {
+    u64 offset = relocs[i];
+    if (offset < sizeof(SceneCacheHeader) || offset > header->relocsOffset - sizeof(uintptr_t) || offset % sizeof(uintptr_t)) return 0;
+    
+    uintptr_t *slot = (uintptr_t *)(file->data + offset);
+    if (*slot < sizeof(SceneCacheHeader) || *slot >= header->relocsOffset) return 0;
+    *slot += (uintptr_t)file->data;
+  }
+  
+  return 1;
+}
+
+// Returns NULL on a miss, a hit stays valid as long as the cache file is mapped
+cgltf_data *LoadSceneCache(MappedFile *file, SceneCacheKey *key, MappedFile *input)
+{
+  SceneCacheHeader header;
+  
+  if (!MapFileCopyOnWrite(file, key->path)) return NULL;
+  
+  if (!RelocateSceneCache(file, key, input, &header))
+  {
+    UnmapFile(file);
+    return NULL;
+  }
+  
+  cgltf_data *data = (cgltf_data *)(file->data + sizeof(SceneCacheHeader));
+  data->bin = header.binSize ? input->data + header.binOffset : NULL;
+  data->bin_size = header.binSize;
+  return data;
+}
+
+// Saving
+
+static void *CacheArray(SceneCacheWriter *writer, cgltf_size count, size_t size)
+{
+  return count ? Alloc(writer->blob, count * size) : NULL;
+}
+
+static char *CacheString(SceneCacheWriter *writer, const char *string)
+{
+  if (!string) return NULL;
+  
+  size_t size = strlen(string) + 1;
+  char *copy = (char *)AllocNoZero(writer->blob, size);
+  memcpy(copy, string, size);
+  return copy;
+}
+
+// Records a pointer slot of the blob, called once the slot holds its final value
+static void CachePointer(SceneCacheWriter *writer, void *slot)
+{
+  if (*(void **)slot) writer->relocs[writer->relocsCount++] = (u64)((uc *)slot - writer->base);
+}
+
+#define REBASE(pointer, from, to) ((pointer) ? (to) + ((pointer) - (from)) : NULL)
+
+i32 SaveSceneCache(SceneCacheKey *key, cgltf_data *data, MappedFile *input)
+{
+  TmpArena blobTmp = GetScratch(NULL, 0);
+  if (!blobTmp.arena) return 0;
+  
+  TmpArena relocsTmp = GetScratch(&blobTmp.arena, 1);
+  if (!relocsTmp.arena)
+  {
+    ReleaseScratch(&blobTmp);
+    return 0;
+  }
+  
+  // Upper bound of the pointers written below, only non NULL ones are recorded
+  u64 relocsCapacity = 6 + 3 * data->accessors_count + 2 * data->buffer_views_count + data->buffers_count;
+  for (cgltf_size i = 0; i < data->meshes_count; ++i)
+  {
+    relocsCapacity += 1 + 3 * data->meshes[i].primitives_count;
+    for (cgltf_size j = 0; j < data->meshes[i].primitives_count; ++j)
+    {
+      relocsCapacity += 2 * data->meshes[i].primitives[j].attributes_count;
+    }
+  }
+  
+  SceneCacheWriter writer = {0};
+  writer.blob = blobTmp.arena;
+  writer.relocs = (u64 *)AllocNoZero(relocsTmp.arena, relocsCapacity * sizeof(u64));
+  
+  cgltf_data *cached = New(writer.blob, cgltf_data);
+  writer.base = (uc *)cached;
+  
+  cached->file_type = data->file_type;
+  cached->meshes_count = data->meshes_count;
+  cached->accessors_count = data->accessors_count;
+  cached->buffer_views_count = data->buffer_views_count;
+  cached->buffers_count = data->buffers_count;
+  cached->materials_count = data->materials_count;
+  cached->meshes = (cgltf_mesh *)CacheArray(&writer, data->meshes_count, sizeof(cgltf_mesh));
+  cached->accessors = (cgltf_accessor *)CacheArray(&writer, data->accessors_count, sizeof(cgltf_accessor));
+  cached->buffer_views = (cgltf_buffer_view *)CacheArray(&writer, data->buffer_views_count, sizeof(cgltf_buffer_view));
+  cached->buffers = (cgltf_buffer *)CacheArray(&writer, data->buffers_count, sizeof(cgltf_buffer));
+  cached->materials = (cgltf_material *)CacheArray(&writer, data->materials_count, sizeof(cgltf_material));
+  cached->asset.generator = CacheString(&writer, data->asset.generator);
+  
+  CachePointer(&writer, &cached->meshes);
+  CachePointer(&writer, &cached->accessors);
+  CachePointer(&writer, &cached->buffer_views);
+  CachePointer(&writer, &cached->buffers);
+  CachePointer(&writer, &cached->materials);
+  CachePointer(&writer, &cached->asset.generator);
+  
+  for (cgltf_size i = 0; i < data->meshes_count; ++i)
+  {
+    cgltf_mesh *mesh = &data->meshes[i];
+    cgltf_mesh *cachedMesh = &cached->meshes[i];
+    
+    cachedMesh->primitives_count = mesh->primitives_count;
+    cachedMesh->primitives = (cgltf_primitive *)CacheArray(&writer, mesh->primitives_count, sizeof(cgltf_primitive));
+    CachePointer(&writer, &cachedMesh->primitives);
+    
+    for (cgltf_size j = 0; j < mesh->primitives_count; ++j)
+    {
+      cgltf_primitive *primitive = &mesh->primitives[j];
+      cgltf_primitive *cachedPrimitive = &cachedMesh->primitives[j];
+      
+      cachedPrimitive->type = primitive->type;
+      cachedPrimitive->indices = REBASE(primitive->indices, data->accessors, cached->accessors);
+      cachedPrimitive->material = REBASE(primitive->material, data->materials, cached->materials);
+      cachedPrimitive->attributes_count = primitive->attributes_count;
+      cachedPrimitive->attributes = (cgltf_attribute *)CacheArray(&writer, primitive->attributes_count, sizeof(cgltf_attribute));
+      CachePointer(&writer, &cachedPrimitive->indices);
+      CachePointer(&writer, &cachedPrimitive->material);
+      CachePointer(&writer, &cachedPrimitive->attributes);
+      
+      for (cgltf_size k = 0; k < primitive->attributes_count; ++k)
+      {
+        cgltf_attribute *attribute = &primitive->attributes[k];
+        cgltf_attribute *cachedAttribute = &cachedPrimitive->attributes[k];
+        
+        cachedAttribute->name = CacheString(&writer, attribute->name);
+        cachedAttribute->type = attribute->type;
+        cachedAttribute->index = attribute->index;
+        cachedAttribute->data = REBASE(attribute->data, data->accessors, cached->accessors);
+        CachePointer(&writer, &cachedAttribute->name);
+        CachePointer(&writer, &cachedAttribute->data);
+      }
+    }
+  }
+  
+  for (cgltf_size i = 0; i < data->accessors_count; ++i)
+  {
+    cgltf_accessor *accessor = &data->accessors[i];
+    cgltf_accessor *cachedAccessor = &cached->accessors[i];
+    
+    cachedAccessor->component_type = accessor->component_type;
+    cachedAccessor->normalized = accessor->normalized;
+    cachedAccessor->type = accessor->type;
+    cachedAccessor->offset = accessor->offset;
+    cachedAccessor->count = accessor->count;
+    cachedAccessor->stride = accessor->stride;
+    cachedAccessor->has_min = accessor->has_min;
+    cachedAccessor->has_max = accessor->has_max;
+    memcpy(cachedAccessor->min, accessor->min, sizeof(accessor->min));
+    memcpy(cachedAccessor->max, accessor->max, sizeof(accessor->max));
+    cachedAccessor->is_sparse = accessor->is_sparse;
+    cachedAccessor->sparse = accessor->sparse;
+    cachedAccessor->buffer_view = REBASE(accessor->buffer_view, data->buffer_views, cached->buffer_views);
+    cachedAccessor->sparse.indices_buffer_view = REBASE(accessor->sparse.indices_buffer_view, data->buffer_views, cached->buffer_views);
+    cachedAccessor->sparse.values_buffer_view = REBASE(accessor->sparse.values_buffer_view, data->buffer_views, cached->buffer_views);
+    CachePointer(&writer, &cachedAccessor->buffer_view);
+    CachePointer(&writer, &cachedAccessor->sparse.indices_buffer_view);
+    CachePointer(&writer, &cachedAccessor->sparse.values_buffer_view);
+  }
+  
+  for (cgltf_size i = 0; i < data->buffer_views_count; ++i)
+  {
+    cgltf_buffer_view *view = &data->buffer_views[i];
+    cgltf_buffer_view *cachedView = &cached->buffer_views[i];
+    
+    cachedView->offset = view->offset;
+    cachedView->size = view->size;
+    cachedView->stride = view->stride;
+    cachedView->type = view->type;
+    cachedView->has_meshopt_compression = view->has_meshopt_compression;
+    cachedView->meshopt_compression = view->meshopt_compression;
+    cachedView->buffer = REBASE(view->buffer, data->buffers, cached->buffers);
+    cachedView->meshopt_compression.buffer = REBASE(view->meshopt_compression.buffer, data->buffers, cached->buffers);
+    CachePointer(&writer, &cachedView->buffer);
+    CachePointer(&writer, &cachedView->meshopt_compression.buffer);
+  }
+  
+  for (cgltf_size i = 0; i < data->buffers_count; ++i)
+  {
+    cached->buffers[i].size = data->buffers[i].size;
+    cached->buffers[i].uri = CacheString(&writer, data->buffers[i].uri);
+    CachePointer(&writer, &cached->buffers[i].uri);
+  }
+  
+  // Material factors and texture transforms, textures themselves are never parsed
+  for (cgltf_size i = 0; i < data->materials_count; ++i)
+  {
+    cgltf_material *material = &data->materials[i];
+    cgltf_material *cachedMaterial = &cached->materials[i];
+    
+    cachedMaterial->has_pbr_metallic_roughness = material->has_pbr_metallic_roughness;
+    cachedMaterial->pbr_metallic_roughness = material->pbr_metallic_roughness;
+    cachedMaterial->pbr_metallic_roughness.base_color_texture.texture = NULL;
+    cachedMaterial->pbr_metallic_roughness.metallic_roughness_texture.texture = NULL;
+    memcpy(cachedMaterial->emissive_factor, material->emissive_factor, sizeof(material->emissive_factor));
+    cachedMaterial->alpha_mode = material->alpha_mode;
+    cachedMaterial->alpha_cutoff = material->alpha_cutoff;
+    cachedMaterial->double_sided = material->double_sided;
+    cachedMaterial->unlit = material->unlit;
+  }
+  
+  // Written next to its final name then renamed, concurrent readers never see a partial file
+  SceneCacheHeader header = {0};
+  u64 blobSize = (u64)(writer.blob->data + writer.blob->cur - writer.base);
+  
+  header.magic = SCENE_CACHE_MAGIC;
+  header.version = SCENE_CACHE_VERSION;
+  header.layout = SceneCacheLayout();
+  header.hash = key->hash;
+  header.jsonSize = key->jsonSize;
+  header.binOffset = data->bin ? (u64)((const uc *)data->bin - input->data) : 0;
+  header.binSize = data->bin ? data->bin_size : 0;
+  header.relocsOffset = AlignForward(sizeof(SceneCacheHeader) + blobSize, sizeof(u64));
+  header.relocsCount = writer.relocsCount;
+  
+  size_t tmpPathSize = strlen(key->path) + 5;
+  char *tmpPath = (char *)AllocNoZero(relocsTmp.arena, tmpPathSize);
+  snprintf(tmpPath, tmpPathSize, "%s.tmp", key->path);
+  
+  MappedFile file = {0};
+  i32 saved = CreateMappedFile(&file, tmpPath, header.relocsOffset + header.relocsCount * sizeof(u64));
+  
+  if (saved)
+  {
+    memcpy(file.data + sizeof(SceneCacheHeader), writer.base, blobSize);
+    
+    u64 *relocs = (u64 *)(file.data + header.relocsOffset);
+    for (u64 i = 0; i < writer.relocsCount; ++i)
+    {
+      uintptr_t *slot = (uintptr_t *)(file.data + sizeof(SceneCacheHeader) + writer.relocs[i]);
+      *slot = (uintptr_t)((uc *)*slot - writer.base) + sizeof(SceneCacheHeader);
+      relocs[i] = writer.relocs[i] + sizeof(SceneCacheHeader);
+    }
+    
+    header.checksum = HashBytes(file.data + sizeof(SceneCacheHeader), file.size - sizeof(SceneCacheHeader));
+    memcpy(file.data, &header, sizeof(SceneCacheHeader));
+    UnmapFile(&file);
+    saved = rename(tmpPath, key->path) == 0;
+    if (!saved) remove(tmpPath);
+  }
+  
+  ReleaseScratch(&relocsTmp);
+  ReleaseScratch(&blobTmp);
+  return saved;
+}
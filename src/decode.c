@@ -0,0 +1,422 @@
+/*
+  Copyright (c) 2025 Alexandre Perché (@vegasword)
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Attribute decoding, any component type and normalization glTF allows is
+// converted to the quantized Vertex fields. Each attribute gets a decoder for
+// its exact format, the common ones have their own loop and the rest read
+// components through cgltf. Decoders fill a block of count vertices from data,
+// which already points at the first of them.
+//
+//   position   u16 kept, others quantized on a uniform grid over their bounds
+//   normal     i8 normalized kept, others rounded to i8 normalized
+//   tangent    same as normals, w included
+//   texcoord   u16 normalized kept, u8 normalized widened, others quantized
+//              over their bounds which are folded into the uv transform
+
+typedef struct AttributeFormat AttributeFormat;
+
+typedef void (*AttributeDecoder)(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format);
+
+struct AttributeFormat {
+  AttributeDecoder decode;
+  cgltf_component_type componentType;
+  cgltf_bool normalized;
+  i32 quantized; // Stored = (value - offset) * scale, over extent
+  f32 offset[3];
+  f32 extent[3];
+  f32 scale[3];
+};
+
+typedef struct VertexFormats {
+  AttributeFormat position, normal, tangent, texcoord;
+} VertexFormats;
+
+static inline u16 QuantizeUnorm16(f32 value)
+{
+  return (u16)(MIN(MAX(value, 0.0f), 65535.0f) + 0.5f);
+}
+
+static inline i8 QuantizeSnorm8(f32 value)
+{
+  value = MIN(MAX(value, -1.0f), 1.0f) * 127.0f;
+  return (i8)(value + copysignf(0.5f, value)); // Rounded away from zero without a branch
+}
+
+// Positions
+
+static void DecodePositionU16(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  (void)format;
+  for (size_t j = 0; j < count; ++j)
+  {
+    u16 *position = (u16 *)(data + j * stride);
+    block[j].x = position[0];
+    block[j].y = position[1];
+    block[j].z = position[2];
+  }
+}
+
+static void DecodePositionF32(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  f32 *offset = format->offset, *scale = format->scale;
+  for (size_t j = 0; j < count; ++j)
+  {
+    f32 *position = (f32 *)(data + j * stride);
+    block[j].x = QuantizeUnorm16((position[0] - offset[0]) * scale[0]);
+    block[j].y = QuantizeUnorm16((position[1] - offset[1]) * scale[1]);
+    block[j].z = QuantizeUnorm16((position[2] - offset[2]) * scale[2]);
+  }
+}
+
+static void DecodePositionAny(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  f32 *offset = format->offset, *scale = format->scale;
+  size_t size = cgltf_component_size(format->componentType);
+  for (size_t j = 0; j < count; ++j)
+  {
+    uc *position = data + j * stride;
+    block[j].x = QuantizeUnorm16((cgltf_component_read_float(position, format->componentType, format->normalized) - offset[0]) * scale[0]);
+    block[j].y = QuantizeUnorm16((cgltf_component_read_float(position + size, format->componentType, format->normalized) - offset[1]) * scale[1]);
+    block[j].z = QuantizeUnorm16((cgltf_component_read_float(position + 2 * size, format->componentType, format->normalized) - offset[2]) * scale[2]);
+  }
+}
+
+// Normals
+
+static void DecodeNormalI8(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  (void)format;
+  for (size_t j = 0; j < count; ++j)
+  {
+    i8 *normal = (i8 *)(data + j * stride);
+    block[j].nx = normal[0];
+    block[j].ny = normal[1];
+    block[j].nz = normal[2];
+  }
+}
+
+static void DecodeNormalI16(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  (void)format;
+  for (size_t j = 0; j < count; ++j)
+  {
+    i16 *normal = (i16 *)(data + j * stride);
+    block[j].nx = QuantizeSnorm8(normal[0] * (1.0f / 32767.0f));
+    block[j].ny = QuantizeSnorm8(normal[1] * (1.0f / 32767.0f));
+    block[j].nz = QuantizeSnorm8(normal[2] * (1.0f / 32767.0f));
+  }
+}
+
+static void DecodeNormalF32(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  (void)format;
+  for (size_t j = 0; j < count; ++j)
+  {
+    f32 *normal = (f32 *)(data + j * stride);
+    block[j].nx = QuantizeSnorm8(normal[0]);
+    block[j].ny = QuantizeSnorm8(normal[1]);
+    block[j].nz = QuantizeSnorm8(normal[2]);
+  }
+}
+
+static void DecodeNormalAny(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  size_t size = cgltf_component_size(format->componentType);
+  for (size_t j = 0; j < count; ++j)
+  {
+    uc *normal = data + j * stride;
+    block[j].nx = QuantizeSnorm8(cgltf_component_read_float(normal, format->componentType, format->normalized));
+    block[j].ny = QuantizeSnorm8(cgltf_component_read_float(normal + size, format->componentType, format->normalized));
+    block[j].nz = QuantizeSnorm8(cgltf_component_read_float(normal + 2 * size, format->componentType, format->normalized));
+  }
+}
+
+// Tangents
+
+static void DecodeTangentI8(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  (void)format;
+  for (size_t j = 0; j < count; ++j)
+  {
+    i8 *tangent = (i8 *)(data + j * stride);
+    block[j].tx = tangent[0];
+    block[j].ty = tangent[1];
+    block[j].tz = tangent[2];
+    block[j].handedness = tangent[3];
+  }
+}
+
+static void DecodeTangentI16(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  (void)format;
+  for (size_t j = 0; j < count; ++j)
+  {
+    i16 *tangent = (i16 *)(data + j * stride);
+    block[j].tx = QuantizeSnorm8(tangent[0] * (1.0f / 32767.0f));
+    block[j].ty = QuantizeSnorm8(tangent[1] * (1.0f / 32767.0f));
+    block[j].tz = QuantizeSnorm8(tangent[2] * (1.0f / 32767.0f));
+    block[j].handedness = QuantizeSnorm8(tangent[3] * (1.0f / 32767.0f));
+  }
+}
+
+static void DecodeTangentF32(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  (void)format;
+  for (size_t j = 0; j < count; ++j)
+  {
+    f32 *tangent = (f32 *)(data + j * stride);
+    block[j].tx = QuantizeSnorm8(tangent[0]);
+    block[j].ty = QuantizeSnorm8(tangent[1]);
+    block[j].tz = QuantizeSnorm8(tangent[2]);
+    block[j].handedness = QuantizeSnorm8(tangent[3]);
+  }
+}
+
+static void DecodeTangentAny(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  size_t size = cgltf_component_size(format->componentType);
+  for (size_t j = 0; j < count; ++j)
+  {
+    uc *tangent = data + j * stride;
+    block[j].tx = QuantizeSnorm8(cgltf_component_read_float(tangent, format->componentType, format->normalized));
+    block[j].ty = QuantizeSnorm8(cgltf_component_read_float(tangent + size, format->componentType, format->normalized));
+    block[j].tz = QuantizeSnorm8(cgltf_component_read_float(tangent + 2 * size, format->componentType, format->normalized));
+    block[j].handedness = QuantizeSnorm8(cgltf_component_read_float(tangent + 3 * size, format->componentType, format->normalized));
+  }
+}
+
+// Texcoords
+
+static void DecodeTexcoordU16(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  (void)format;
+  for (size_t j = 0; j < count; ++j)
+  {
+    u16 *texcoord = (u16 *)(data + j * stride);
+    block[j].u = texcoord[0];
+    block[j].v = texcoord[1];
+  }
+}
+
+static void DecodeTexcoordU8(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  (void)format;
+  for (size_t j = 0; j < count; ++j)
+  {
+    u8 *texcoord = data + j * stride;
+    block[j].u = (u16)(texcoord[0] * 257);
+    block[j].v = (u16)(texcoord[1] * 257);
+  }
+}
+
+static void DecodeTexcoordF32(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  f32 *offset = format->offset, *scale = format->scale;
+  for (size_t j = 0; j < count; ++j)
+  {
+    f32 *texcoord = (f32 *)(data + j * stride);
+    block[j].u = QuantizeUnorm16((texcoord[0] - offset[0]) * scale[0]);
+    block[j].v = QuantizeUnorm16((texcoord[1] - offset[1]) * scale[1]);
+  }
+}
+
+static void DecodeTexcoordAny(Vertex *block, size_t count, uc *data, size_t stride, AttributeFormat *format)
+{
+  f32 *offset = format->offset, *scale = format->scale;
+  size_t size = cgltf_component_size(format->componentType);
+  for (size_t j = 0; j < count; ++j)
+  {
+    uc *texcoord = data + j * stride;
+    block[j].u = QuantizeUnorm16((cgltf_component_read_float(texcoord, format->componentType, format->normalized) - offset[0]) * scale[0]);
+    block[j].v = QuantizeUnorm16((cgltf_component_read_float(texcoord + size, format->componentType, format->normalized) - offset[1]) * scale[1]);
+  }
+}
+
+// Decoder selection
+
+// Every attribute read as stored in Vertex, what gltfpack writes by default
+void InitVertexFormats(VertexFormats *formats)
+{
+  memset(formats, 0, sizeof(VertexFormats));
+  formats->position.decode = DecodePositionU16;
+  formats->normal.decode = DecodeNormalI8;
+  formats->tangent.decode = DecodeTangentI8;
+  formats->texcoord.decode = DecodeTexcoordU16;
+}
+
+i32 IsNativeFormats(VertexFormats *formats)
+{
+  return formats->position.decode == DecodePositionU16 && formats->normal.decode == DecodeNormalI8 &&
+         formats->tangent.decode == DecodeTangentI8 && formats->texcoord.decode == DecodeTexcoordU16;
+}
+
+// Bounds of the first components of an accessor, from its min/max when given
+static void AccessorBounds(cgltf_accessor *accessor, uc *data, cgltf_size components, f32 *minimum, f32 *maximum)
+{
+  if (accessor->has_min && accessor->has_max)
+  {
+    for (cgltf_size k = 0; k < components; ++k) minimum[k] = accessor->min[k], maximum[k] = accessor->max[k];
+    return;
+  }
+  
+  size_t size = cgltf_component_size(accessor->component_type);
+  for (cgltf_size k = 0; k < components; ++k) minimum[k] = 1e30f, maximum[k] = -1e30f;
+  
+  for (cgltf_size j = 0; j < accessor->count; ++j)
+  {
+    uc *element = data + j * accessor->stride;
+    for (cgltf_size k = 0; k < components; ++k)
+    {
+      f32 value = cgltf_component_read_float(element + k * size, accessor->component_type, accessor->normalized);
+      minimum[k] = MIN(minimum[k], value);
+      maximum[k] = MAX(maximum[k], value);
+    }
+  }
+  
+  if (!accessor->count) for (cgltf_size k = 0; k < components; ++k) minimum[k] = maximum[k] = 0.0f;
+}
+
+// Picks the decoder of an attribute and its quantization, data points at the
+// first element of the accessor. Returns 0 when the accessor type doesn't fit
+// the attribute.
+i32 SelectAttributeFormat(VertexFormats *formats, cgltf_attribute_type type, cgltf_accessor *accessor, uc *data)
+{
+  cgltf_component_type component = accessor->component_type;
+  cgltf_bool normalized = accessor->normalized;
+  AttributeFormat *format = NULL;
+  
+  switch (type)
+  {
+    case cgltf_attribute_type_position: {
+      if (accessor->type != cgltf_type_vec3) return 0;
+      format = &formats->position;
+      if (component == cgltf_component_type_r_16u && !normalized) format->decode = DecodePositionU16;
+      else if (component == cgltf_component_type_r_32f) format->decode = DecodePositionF32;
+      else format->decode = DecodePositionAny;
+    } break;
+    
+    case cgltf_attribute_type_normal: {
+      if (accessor->type != cgltf_type_vec3) return 0;
+      format = &formats->normal;
+      if (component == cgltf_component_type_r_8 && normalized) format->decode = DecodeNormalI8;
+      else if (component == cgltf_component_type_r_16 && normalized) format->decode = DecodeNormalI16;
+      else if (component == cgltf_component_type_r_32f) format->decode = DecodeNormalF32;
+      else format->decode = DecodeNormalAny;
+    } break;
+    
+    case cgltf_attribute_type_tangent: {
+      if (accessor->type != cgltf_type_vec4) return 0;
+      format = &formats->tangent;
+      if (component == cgltf_component_type_r_8 && normalized) format->decode = DecodeTangentI8;
+      else if (component == cgltf_component_type_r_16 && normalized) format->decode = DecodeTangentI16;
+      else if (component == cgltf_component_type_r_32f) format->decode = DecodeTangentF32;
+      else format->decode = DecodeTangentAny;
+    } break;
+    
+    case cgltf_attribute_type_texcoord: {
+      if (accessor->type != cgltf_type_vec2) return 0;
+      format = &formats->texcoord;
+      if (component == cgltf_component_type_r_16u && normalized) format->decode = DecodeTexcoordU16;
+      else if (component == cgltf_component_type_r_8u && normalized) format->decode = DecodeTexcoordU8;
+      else if (component == cgltf_component_type_r_32f) format->decode = DecodeTexcoordF32;
+      else format->decode = DecodeTexcoordAny;
+    } break;
+    
+    default: return 0;
+  }
+  
+  format->componentType = component;
+  format->normalized = normalized;
+  
+  // Positions share one scale so the model keeps its proportions, texcoords
+  // are scaled per axis since their transform is per axis too
+  format->quantized = format->decode == DecodePositionF32 || format->decode == DecodePositionAny ||
+                      format->decode == DecodeTexcoordF32 || format->decode == DecodeTexcoordAny;
+  
+  if (type == cgltf_attribute_type_position && format->quantized)
+  {
+    f32 maximum[3];
+    AccessorBounds(accessor, data, 3, format->offset, maximum);
+    f32 extent = MAX(maximum[0] - format->offset[0], MAX(maximum[1] - format->offset[1], maximum[2] - format->offset[2]));
+    for (i32 k = 0; k < 3; ++k)
+    {
+      format->extent[k] = extent;
+      format->scale[k] = extent > 0.0f ? 65535.0f / extent : 0.0f;
+    }
+  }
+  else if (format->quantized)
+  {
+    f32 maximum[2];
+    AccessorBounds(accessor, data, 2, format->offset, maximum);
+    for (i32 k = 0; k < 2; ++k)
+    {
+      format->extent[k] = maximum[k] - format->offset[k];
+      format->scale[k] = format->extent[k] > 0.0f ? 65535.0f / format->extent[k] : 0.0f;
+    }
+  }
+  
+  return 1;
+}
+
+// Position component as its decoder writes it, so boundaries declared by the
+// accessor compare with the ones of the vertices. Quantized positions are
+// offset and scaled by those same boundaries, a mismatch means the accessor
+// declares boundaries its elements don't reach or exceed.
+u16 EncodePosition(AttributeFormat *format, i32 component, f32 value)
+{
+  if (!format->quantized) return (u16)value;
+  return QuantizeUnorm16((value - format->offset[component]) * format->scale[component]);
+}
+
+// Indices must be 8, 16 or 32-bit, the 32-bit ones are scanned since they are
+// narrowed to the 16-bit ones of the output. Returns 0 when they can't be.
+i32 CheckIndices(cgltf_accessor *accessor, uc *data)
+{
+  if (accessor->component_type == cgltf_component_type_r_8u || accessor->component_type == cgltf_component_type_r_16u) return 1;
+  if (accessor->component_type != cgltf_component_type_r_32u) return 0;
+  
+  u32 bits = 0;
+  for (cgltf_size j = 0; j < accessor->count; ++j) bits |= *(u32 *)(data + j * accessor->stride);
+  return bits <= UINT16_MAX;
+}
+
+// Indices that passed CheckIndices narrowed to 16-bit
+void DecodeIndices(u16 *indices, cgltf_accessor *accessor, uc *data)
+{
+  size_t stride = accessor->stride;
+  
+  switch (accessor->component_type)
+  {
+    case cgltf_component_type_r_16u: {
+      if (stride == sizeof(u16)) memcpy(indices, data, accessor->count * sizeof(u16));
+      else for (cgltf_size j = 0; j < accessor->count; ++j) indices[j] = *(u16 *)(data + j * stride);
+    } break;
+    
+    case cgltf_component_type_r_8u: {
+      for (cgltf_size j = 0; j < accessor->count; ++j) indices[j] = data[j * stride];
+    } break;
+    
+    case cgltf_component_type_r_32u: {
+      for (cgltf_size j = 0; j < accessor->count; ++j) indices[j] = (u16)*(u32 *)(data + j * stride);
+    } break;
+    
+    default: break;
+  }
+}
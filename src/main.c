@@ -27,18 +27,19 @@
 
 #include "stdio.h"
 #include "stdint.h"
+#include "math.h"
 #include "assert.h"
 
-#define WIN32_LEAN_AND_MEAN
-#include "windows.h"
-
 #define CGLTF_IMPLEMENTATION
 #include "cgltf.h"
 
 #include "type.c"
+#include "platform.c"
 #include "arena.c"
+#include "parallel.c"
+#include "cache.c"
 
-#define CHECK(condition, message, ...) if (!(condition)) { fprintf(stderr, message, __VA_ARGS__); return 1; }
+#define CHECK(condition, ...) if (!(condition)) { fprintf(stderr, __VA_ARGS__); return 1; }
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
 
@@ -61,51 +62,251 @@ typedef struct Model {
   f32 roughnessFactor;
   u16 minBoundary[3];
   u16 maxBoundary[3];
+  f32 sphereCenter[3];
+  f32 sphereRadius;
   u16 *indices;
   Vertex *vertices;
 } Model;
 
+#define MODEL_HEADER_SIZE (4 * sizeof(u32) + 10 * sizeof(f32) + 6 * sizeof(u16))
+
+#include "decode.c"
+#include "assembly.c"
+#include "bounds.c"
+
+// cgltf allocations are bumped from the arena, everything is released at once with it.
+// Elements parsed on a worker land in that worker's arena instead.
+
+void *CgltfArenaAlloc(void *user, cgltf_size size)
+{
+  return AllocNoZero(workerArena ? workerArena : (Arena *)user, size);
+}
+
+void CgltfArenaFree(void *user, void *ptr)
+{
+  (void)user;
+  (void)ptr;
+}
+
+i32 CgltfParallelFor(void *user, cgltf_size count, i32 (*task)(void *data, cgltf_size begin, cgltf_size end), void *data)
+{
+  return ParallelFor((WorkerPool *)user, count, task, data);
+}
+
+// External buffers are mapped (their read-ahead starts right away), data URIs
+// decoded and the GLB binary chunk read in place. Ranges of buffers run on
+// workers so scenes split over many .bin files overlap their reads. File URIs
+// are relative to the glTF itself.
+
+typedef struct LoadedBuffer {
+  MappedFile file;
+  uc *data;
+  i32 used;
+  const char *error;
+} LoadedBuffer;
+
+typedef struct BufferLoad {
+  const char *inputPath;
+  cgltf_options *options;
+  cgltf_data *data;
+  LoadedBuffer *buffers;
+} BufferLoad;
+
+i32 LoadBufferRange(void *user, size_t begin, size_t end)
+{
+  BufferLoad *load = (BufferLoad *)user;
+  i32 result = 0;
+  
+  for (size_t i = begin; i < end; ++i)
+  {
+    cgltf_buffer *buffer = &load->data->buffers[i];
+    LoadedBuffer *loaded = &load->buffers[i];
+    if (!loaded->used) continue;
+    
+    if (buffer->uri && strncmp(buffer->uri, "data:", 5) == 0)
+    {
+      char *comma = strchr(buffer->uri, ',');
+      cgltf_result decoded = cgltf_result_success;
+      if (!comma || comma - buffer->uri < 7 || strncmp(comma - 7, ";base64", 7) != 0) loaded->error = "only base64 data URIs are supported";
+      else decoded = cgltf_load_buffer_base64(load->options, buffer->size, comma + 1, (void **)&loaded->data);
+      
+      if (decoded == cgltf_result_out_of_memory) loaded->error = "out of memory (arena limit)";
+      else if (decoded != cgltf_result_success) loaded->error = "invalid base64 data";
+    }
+    else if (buffer->uri)
+    {
+      char *path = (char *)CgltfArenaAlloc(load->options->memory.user_data, strlen(load->inputPath) + strlen(buffer->uri) + 1);
+      if (path)
+      {
+        cgltf_combine_paths(path, load->inputPath, buffer->uri);
+        cgltf_decode_uri(path + strlen(path) - strlen(buffer->uri));
+      }
+      
+      if (!path) loaded->error = "out of memory (arena limit)";
+      else if (!MapFile(&loaded->file, path)) loaded->error = "failed to map";
+      else if (loaded->file.size < buffer->size) loaded->error = "smaller than its declared byte length";
+      else loaded->data = loaded->file.data;
+    }
+    else if (i == 0 && load->data->bin && load->data->bin_size >= buffer->size)
+    {
+      loaded->data = (uc *)load->data->bin;
+    }
+    else
+    {
+      loaded->error = "missing or truncated GLB binary chunk";
+    }
+    
+    if (loaded->error) result = -1;
+  }
+  
+  return result;
+}
+
+uc *BufferViewData(cgltf_buffer_view *view, cgltf_data *data, LoadedBuffer *buffers)
+{
+  return buffers[view->buffer - data->buffers].data + view->offset;
+}
+
+// Elements of an accessor must lie in its buffer view and the view in its
+// buffer, which is at least as large as declared once loaded
+i32 AccessorInBounds(cgltf_accessor *accessor)
+{
+  cgltf_buffer_view *view = accessor->buffer_view;
+  cgltf_size element = cgltf_calc_size(accessor->type, accessor->component_type);
+  
+  if (view->offset > view->buffer->size || view->size > view->buffer->size - view->offset) return 0;
+  if (!accessor->count) return 1;
+  if (!accessor->stride || accessor->offset > view->size || element > view->size - accessor->offset) return 0;
+  return accessor->count - 1 <= (view->size - accessor->offset - element) / accessor->stride;
+}
+
+// Upper bound of the arena address space, override with --arena-limit
+#ifndef ARENA_RESERVE_SIZE
+#define ARENA_RESERVE_SIZE (16 * GB)
+#endif
+
 i32 main(i32 argc, char **argv)
 { 
-  if (argc != 3) {
-    printf("Usage: gltf2custom [input: *.gltf/glb] [output]");
+  char *inputPath = NULL, *outputPath = NULL, *cacheDirectory = NULL;
+  size_t arenaLimit = ARENA_RESERVE_SIZE;
+  i32 stats = 0, statsJson = 0, hugePages = 0, validate = 0, bench = 0, threads = CpuCount();
+  
+  for (i32 i = 1; i < argc; ++i)
+  {
+    if (strcmp(argv[i], "--arena-limit") == 0 && i + 1 < argc) arenaLimit = (size_t)strtoull(argv[++i], NULL, 10) * MB;
+    else if (strcmp(argv[i], "--stats") == 0) stats = 1;
+    else if (strcmp(argv[i], "--stats=json") == 0) stats = statsJson = 1;
+    else if (strcmp(argv[i], "--huge-pages") == 0) hugePages = 1;
+    else if (strcmp(argv[i], "--validate") == 0) validate = 1;
+    else if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc) bench = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) cacheDirectory = argv[++i];
+    else if (!inputPath) inputPath = argv[i];
+    else if (!outputPath) outputPath = argv[i];
+  }
+  
+  if (!inputPath || !outputPath || !arenaLimit || threads < 1) {
+    printf("Usage: gltf2custom [--arena-limit <MB>] [--huge-pages] [--threads <N>] [--cache <dir>] [--validate] [--bench <runs>] [--stats[=json]] [input: *.gltf/glb] [output]");
     return 1;
   }
   
+  // The input stays mapped for the whole conversion, GLB BIN chunk is read in place
+  MappedFile inputFile = {0};
+  CHECK(MapFile(&inputFile, inputPath), "Failed to map %s", inputPath);
+  
+  // Parsing peaks at about 4 times the JSON size, only that much gets huge pages,
+  // anything allocated past it continues on regular pages
   Arena arena = {0};
-  InitArena(&arena, VirtualAlloc(NULL, 1*GB, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE), 1*GB);
+  size_t arenaHugePages = hugePages ? (size_t)inputFile.size * 4 : 0;
+  CHECK(ReserveArena(&arena, arenaLimit, arenaHugePages), "Failed to reserve %zu bytes of address space", arenaLimit);
+  
+  WorkerPool workers = {0};
+  InitWorkerPool(&workers, threads);
 
   // glTF parsing and validation
   
+  f64 parseStart = Clock();
+  
   Model model = {0};
-  char *inputPath = argv[1], *outputPath = argv[2];
   
   cgltf_options options = {0};  
+  options.memory.alloc_func = CgltfArenaAlloc;
+  options.memory.free_func = CgltfArenaFree;
+  options.memory.user_data = &arena;
+  options.json_single_pass = 1;
+  options.skip_sections = cgltf_parse_section_geometry_only;
+  if (workers.count > 1)
+  {
+    options.parallel.parallel_for = CgltfParallelFor;
+    options.parallel.user_data = &workers;
+  }
   cgltf_data* data = NULL;
   
-  CHECK(cgltf_parse_file(&options, inputPath, &data) == cgltf_result_success,  "Failed to parse %s", argv[1]);
-  CHECK(strncmp(data->asset.generator, "gltfpack", 8) == 0, "Model vertices should be gltfpack optimized")
+  // Reusing the parsed scene of a previous run on the same JSON, --cache
+  MappedFile cacheFile = {0};
+  SceneCacheKey cacheKey = {0};
+  
+  if (cacheDirectory)
+  {
+    cacheKey = GetSceneCacheKey(&arena, cacheDirectory, &inputFile);
+    data = LoadSceneCache(&cacheFile, &cacheKey, &inputFile);
+  }
+  
+  if (!data)
+  {
+    CHECK(cgltf_parse(&options, inputFile.data, inputFile.size, &data) == cgltf_result_success,  "Failed to parse %s", inputPath);
+    if (cacheDirectory && !SaveSceneCache(&cacheKey, data, &inputFile)) fprintf(stderr, "Failed to write %s\n", cacheKey.path);
+  }
+  
   CHECK(data->meshes && data->meshes_count == 1 && data->meshes->primitives_count == 1, "Model must be merged into a single mesh");
   CHECK(data->accessors_count > 0, "Model doesn't contains any accessors (required to get its boundaries)")
   
   cgltf_mesh *mesh = &data->meshes[0];  
   cgltf_primitive *primitive = mesh->primitives;
-  cgltf_accessor *accessors = data->accessors;
   
   CHECK(primitive->type == cgltf_primitive_type_triangles, "Model must be triangulated")
+  CHECK(primitive->attributes_count > 0 && primitive->attributes->data, "Primitive has no attributes");
+  
+  // Loading every buffer the primitive reads from, concurrently
   
-  // Reading buffer file
+  LoadedBuffer *buffers = (LoadedBuffer *)Alloc(&arena, data->buffers_count * sizeof(LoadedBuffer));
   
-  char *bufferUri = data->buffer_views->buffer->uri;
+  CHECK(primitive->indices && primitive->indices->buffer_view, "Model indices must be stored in a buffer view");
+  buffers[primitive->indices->buffer_view->buffer - data->buffers].used = 1;
   
-  HANDLE bufferFile = CreateFileA(bufferUri, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
-  DWORD bytesRead;
+  for (cgltf_size i = 0; i < primitive->attributes_count; ++i)
+  {
+    cgltf_accessor *accessor = primitive->attributes[i].data;
+    CHECK(accessor && accessor->buffer_view, "Model attributes must be stored in buffer views");
+    buffers[accessor->buffer_view->buffer - data->buffers].used = 1;
+  }
+  
+  BufferLoad bufferLoad = { inputPath, &options, data, buffers };
+  if (ParallelFor(&workers, data->buffers_count, LoadBufferRange, &bufferLoad) < 0)
+  {
+    for (cgltf_size i = 0; i < data->buffers_count; ++i)
+    {
+      cgltf_buffer *buffer = &data->buffers[i];
+      CHECK(!buffers[i].error, "Failed to load buffer %zu (%s): %s", i, buffer->uri && strncmp(buffer->uri, "data:", 5) != 0 ? buffer->uri : buffer->uri ? "data URI" : "GLB binary chunk", buffers[i].error);
+    }
+    CHECK(0, "Failed to load buffers");
+  }
   
-  cgltf_size bufferSize = data->buffers->size;
-  uc *bufferData = (uc *)Alloc(&arena, bufferSize);
+  // Accessors are read in place, their ranges are always checked. Untrusted
+  // inputs, --validate also checks that every index addresses an existing
+  // vertex before any of it is copied
   
-  CHECK(ReadFile(bufferFile, bufferData, (DWORD)bufferSize, &bytesRead, NULL) && bufferSize == bytesRead, "Failed to read file");
-  CloseHandle(bufferFile);
+  CHECK(AccessorInBounds(primitive->indices), "Model indices don't fit in their buffer view");
+  for (cgltf_size i = 0; i < primitive->attributes_count; ++i)
+  {
+    CHECK(AccessorInBounds(primitive->attributes[i].data), "Vertices %s don't fit in their buffer view", primitive->attributes[i].name);
+  }
+  
+  if (validate)
+  {
+    for (cgltf_size i = 0; i < data->buffers_count; ++i) data->buffers[i].data = buffers[i].data;
+    CHECK(cgltf_validate(data) == cgltf_result_success, "%s failed validation", inputPath);
+  }
   
   // Fetching metallic-roughness material
   
@@ -122,160 +323,360 @@ i32 main(i32 argc, char **argv)
   model.metallicFactor = pbrMetallicRoughness.metallic_factor;
   model.roughnessFactor = pbrMetallicRoughness.roughness_factor;
   
-  // Fetching texture transform
+  // Fetching texture transform, identity without KHR_texture_transform
+  
+  cgltf_texture_view baseColorTexture = material->pbr_metallic_roughness.base_color_texture;
+  cgltf_texture_transform transform = baseColorTexture.transform;
+  i32 texcoordSet = transform.has_texcoord ? transform.texcoord : baseColorTexture.texcoord;
   
-  cgltf_texture_transform transform = material->pbr_metallic_roughness.base_color_texture.transform;
+  if (!baseColorTexture.has_transform) transform.scale[0] = transform.scale[1] = 1.0f;
   
   model.uvOffset[0] = transform.offset[0];
   model.uvOffset[1] = transform.offset[1];
   model.uvScale[0] = transform.scale[0];
   model.uvScale[1] = transform.scale[1];  
     
-  // Fetching indices
-
-  cgltf_accessor *indices = primitive->indices;
-  
-  model.indicesCount = (u32)indices->count;
-  model.indicesSize = (u32)indices->buffer_view->size;  
-  model.indices = (u16 *)Alloc(&arena, model.indicesSize);
-  memcpy(model.indices, bufferData + indices->buffer_view->offset, model.indicesSize);      
-
-  // Fetching vertices and boundaries
+  // Checking indices and picking the decoder of each attribute, nothing can
+  // fail past the output mapping
   
+  cgltf_accessor *indices = primitive->indices;
   cgltf_attribute *attributes = primitive->attributes;
   cgltf_size attributesCount = primitive->attributes_count;
+  uc *indicesData = BufferViewData(indices->buffer_view, data, buffers) + indices->offset;
+  
+  CHECK(!indices->is_sparse, "Model indices can't be sparse");
+  CHECK(CheckIndices(indices, indicesData), "Model indices must be 8, 16 or 32-bit and address at most 65536 vertices");
   
+  model.indicesCount = (u32)indices->count;
+  model.indicesSize = (u32)(indices->count * sizeof(u16));
   model.verticesCount = (u32)attributes->data->count;
   model.verticesSize = model.verticesCount * sizeof(Vertex);
-  model.vertices = (Vertex *)Alloc(&arena, model.verticesSize);
-    
+  
+  f64 extractStart = Clock();
+  
+  VertexStreams streams = {0};
+  VertexFormats formats;
+  cgltf_accessor *positionAccessor = NULL;
+  
+  InitVertexFormats(&formats);
+  
   for (u32 i = 0; i < attributesCount; ++i)
   {
     cgltf_attribute attribute = attributes[i];
-    cgltf_buffer_view bufferView = *attribute.data->buffer_view;
-    uc *pBuffer = bufferData + bufferView.offset;
-    size_t stride = attribute.data->stride;
-    
-    TmpArena tmp = {0};
-    TmpBegin(&tmp, &arena);
+    cgltf_accessor *accessor = attribute.data;
+    uc **stream = NULL;
+    size_t *stride = NULL;
     
     switch (attribute.type)
-    {          
+    {
       case cgltf_attribute_type_position: {
-          
-        CHECK(stride, "Null stride on fetching vertices positions");
-          
-        if (accessors->has_min && data->accessors->has_max)
-        {
-          model.minBoundary[0] = (u16)accessors->min[0];
-          model.maxBoundary[0] = (u16)accessors->max[0];
-          
-          model.minBoundary[1] = (u16)accessors->min[1];
-          model.maxBoundary[1] = (u16)accessors->max[1];
-          
-          model.maxBoundary[2] = (u16)accessors->max[2];
-          model.maxBoundary[2] = (u16)accessors->max[2];
-          
-          for (u32 j = 0; j < model.indicesCount; ++j)
-          {
-            u16 *position = (u16 *)((uc *)pBuffer + j * stride);
-            Vertex *vertex = &model.vertices[j];
-            vertex->x = position[0];
-            vertex->y = position[1];
-            vertex->z = position[2];
-          }
-        }
-        else
-        {
-          model.minBoundary[0] = model.minBoundary[1] = model.minBoundary[2] = UINT16_MAX;
-          model.maxBoundary[0] = model.maxBoundary[1] = model.maxBoundary[2] = 0;
-          
-          for (u32 j = 0; j < model.indicesCount; ++j)
-          {
-            u16 *position = (u16 *)((uc *)pBuffer + j * stride);
-            u16 x = position[0];
-            u16 y = position[1];
-            u16 z = position[2];
-            
-            Vertex *vertex = &model.vertices[j];
-            vertex->x = x;
-            vertex->y = y;
-            vertex->z = z;
-            
-            model.minBoundary[0] = MIN(model.minBoundary[0], x);
-            model.minBoundary[1] = MIN(model.minBoundary[1], y);
-            model.minBoundary[2] = MIN(model.minBoundary[2], z);
-
-            model.maxBoundary[0] = MAX(model.maxBoundary[0], x);
-            model.maxBoundary[1] = MAX(model.maxBoundary[1], y);
-            model.maxBoundary[2] = MAX(model.maxBoundary[2], z);
-          }
-        }
-        
+        stream = &streams.position;
+        stride = &streams.positionStride;
+        positionAccessor = accessor;
       } break;
-
+      
       case cgltf_attribute_type_normal: {
-          
-        CHECK(stride, "Null stride on fetching vertices normals");
-        
-        for (u32 j = 0; j < model.verticesCount; ++j)
-        {          
-          i8 *normal = (i8 *)((uc *)pBuffer + j * stride);
-          Vertex *vertex = &model.vertices[j];
-          vertex->nx = normal[0];
-          vertex->ny = normal[1];
-          vertex->nz = normal[2];
-        }
-        
+        stream = &streams.normal;
+        stride = &streams.normalStride;
       } break;
       
       case cgltf_attribute_type_tangent: {
-          
-        CHECK(stride, "Null stride on fetching vertices tangents");
-        
-        for (u32 j = 0; j < model.verticesCount; ++j)
-        {          
-          i8 *tangent = (i8 *)((uc *)pBuffer + j * stride);
-          Vertex *vertex = &model.vertices[j];
-          vertex->tx = tangent[0];
-          vertex->ty = tangent[1];
-          vertex->tz = tangent[2];
-          vertex->handedness = tangent[3];
-        }
-        
+        stream = &streams.tangent;
+        stride = &streams.tangentStride;
       } break;
       
       case cgltf_attribute_type_texcoord: {
-          
-        CHECK(stride, "Null stride on fetching vertices texcoords");
-        
-        for (u32 j = 0; j < model.verticesCount; ++j)
-        {
-          u16 *texcoord = (u16 *)((uc *)pBuffer + j * stride);
-          Vertex *vertex = &model.vertices[j];
-          vertex->u = texcoord[0];
-          vertex->v = texcoord[1];          
-        }
-        
+        if (attribute.index != texcoordSet) break;
+        stream = &streams.texcoord;
+        stride = &streams.texcoordStride;
       } break;
-
+      
       default: break;
     }
     
+    if (!stream) continue;
+    
+    CHECK(!accessor->is_sparse, "Vertices %s can't be sparse", attribute.name);
+    CHECK(accessor->count == model.verticesCount, "Vertices %s count differs from the other attributes", attribute.name);
+    CHECK(accessor->stride, "Null stride on fetching vertices %s", attribute.name);
+    
+    *stream = BufferViewData(accessor->buffer_view, data, buffers) + accessor->offset;
+    *stride = accessor->stride;
+    CHECK(SelectAttributeFormat(&formats, attribute.type, accessor, *stream), "Vertices %s accessor type isn't supported", attribute.name);
+  }
+  
+  CHECK(positionAccessor, "Model has no POSITION attribute");
+  
+  // Any stream stored differently than Vertex makes every block go through the
+  // decoders, texcoords quantized over their bounds are mapped back by the uv
+  // transform
+  
+  if (!IsNativeFormats(&formats)) streams.formats = &formats;
+  
+  if (formats.texcoord.quantized)
+  {
+    for (i32 k = 0; k < 2; ++k)
+    {
+      model.uvOffset[k] += model.uvScale[k] * formats.texcoord.offset[k];
+      model.uvScale[k] *= formats.texcoord.extent[k];
+    }
+  }
+  
+  // Mapping output, indices and vertices are written in place
+  
+  MappedFile output = {0};
+  u64 outputSize = MODEL_HEADER_SIZE + (u64)model.indicesSize + (u64)model.verticesSize;
+  
+  CHECK(CreateMappedFile(&output, outputPath, outputSize), "Failed to write to %s", outputPath);
+  
+  model.indices = (u16 *)(output.data + MODEL_HEADER_SIZE);
+  model.vertices = (Vertex *)(output.data + MODEL_HEADER_SIZE + model.indicesSize);
+  
+  DecodeIndices(model.indices, indices, indicesData);
+  
+  // Fetching vertices and boundaries
+  
+  u16 minPosition[3], maxPosition[3];
+  FillMissingStreams(&streams);
+  ResetBoundaries(minPosition, maxPosition);
+  if (AssembleVerticesParallel(&workers, &arena, model.vertices, model.verticesCount, &streams, minPosition, maxPosition) != 0)
+  {
+    UnmapFile(&output);
+    remove(outputPath);
+    CHECK(0, "Failed to start vertex assembly workers");
+  }
+  
+  // Boundaries always come from the vertices, the ones of the position
+  // accessor are only checked against them
+  memcpy(model.minBoundary, minPosition, sizeof(minPosition));
+  memcpy(model.maxBoundary, maxPosition, sizeof(maxPosition));
+  
+  if (positionAccessor->has_min && positionAccessor->has_max)
+  {
+    for (i32 k = 0; k < 3; ++k)
+    {
+      u16 minimum = EncodePosition(&formats.position, k, positionAccessor->min[k]);
+      u16 maximum = EncodePosition(&formats.position, k, positionAccessor->max[k]);
+      if (minimum == minPosition[k] && maximum == maxPosition[k]) continue;
+      fprintf(stderr, "Position accessor boundaries differ from its vertices, using the vertices ones\n");
+      break;
+    }
+  }
+  
+  // Only reported by --stats, see bounds.c
+  if (stats) ComputeBoundingSphere(model.vertices, model.verticesCount, model.minBoundary, model.maxBoundary, model.sphereCenter, &model.sphereRadius);
+  
+  f64 extractEnd = Clock();
+  
+  // Fused assembly, scalar, through the packed kernel of this CPU and on the
+  // workers, against the per-attribute loops on the same streams, --bench
+  
+  if (bench > 0 && streams.formats) fprintf(stderr, "--bench only covers vertices stored as in the output, skipped\n");
+  else if (bench > 0)
+  {
+    TmpArena tmp = {0};
+    TmpBegin(&tmp, &arena);
+    
+    Vertex *results[4];
+    u16 minResults[4][3], maxResults[4][3];
+    f64 best[4] = { 1e30, 1e30, 1e30, 1e30 };
+    char threadsName[32];
+    const char *names[4] = { "per attribute", "fused scalar", SelectAssemblyKernel()->name, threadsName };
+    
+    snprintf(threadsName, sizeof(threadsName), "%d threads", workers.count);
+    for (i32 j = 0; j < 4; ++j) results[j] = (Vertex *)Alloc(&arena, model.verticesSize);
+    
+    for (i32 i = 0; i < bench; ++i)
+    {
+      for (i32 j = 0; j < 4; ++j)
+      {
+        f64 start = Clock();
+        ResetBoundaries(minResults[j], maxResults[j]);
+        if (j == 0) AssembleVerticesPerAttribute(results[j], model.verticesCount, &streams, minResults[j], maxResults[j]);
+        else if (j == 1) AssembleVertexRange(results[j], 0, model.verticesCount, &streams, minResults[j], maxResults[j]);
+        else if (j == 2) AssembleVertices(results[j], 0, model.verticesCount, &streams, minResults[j], maxResults[j]);
+        else AssembleVerticesParallel(&workers, &arena, results[j], model.verticesCount, &streams, minResults[j], maxResults[j]);
+        best[j] = MIN(best[j], Clock() - start);
+      }
+    }
+    
+    printf("assembly of %u vertices (%s layout), best of %d runs:\n", model.verticesCount, IsPackedLayout(&streams) ? "packed" : "strided", bench);
+    
+    for (i32 j = 0; j < 4; ++j)
+    {
+      CHECK(memcmp(results[j], results[0], model.verticesSize) == 0 && memcmp(minResults[j], minResults[0], sizeof(minResults[0])) == 0 &&
+            memcmp(maxResults[j], maxResults[0], sizeof(maxResults[0])) == 0, "%s vertex assembly differs from the per-attribute loops", names[j]);
+      printf("  %-14s %.3f ms\n", names[j], best[j] * 1000.0);
+    }
+    
     TmpEnd(&tmp);
   }
+  
+  // JSON parsing on one thread, cgltf_parse tokenizing in two passes against a
+  // single growing pass, then the number tokens through strtod against the
+  // fast path of cgltf_json_to_float and the object keys through a strcmp
+  // chain against cgltf_json_to_key, --bench
+  
+  if (bench > 0 && data->json)
+  {
+    TmpArena tmp = {0};
+    const char *names[2] = { "two passes", "single pass" };
+    f64 best[2] = { 1e30, 1e30 };
+    cgltf_options benchOptions = options;
+    memset(&benchOptions.parallel, 0, sizeof(benchOptions.parallel));
+    
+    for (i32 i = 0; i < bench; ++i)
+    {
+      for (i32 j = 0; j < 2; ++j)
+      {
+        cgltf_data *parsed = NULL;
+        benchOptions.json_single_pass = j;
+        benchOptions.json_token_count = 0;
+        TmpBegin(&tmp, &arena);
+        f64 start = Clock();
+        cgltf_result result = cgltf_parse(&benchOptions, inputFile.data, inputFile.size, &parsed);
+        best[j] = MIN(best[j], Clock() - start);
+        TmpEnd(&tmp);
+        CHECK(result == cgltf_result_success, "Failed to parse %s with %s", inputPath, names[j]);
+      }
+    }
+    
+    printf("parse of %zu bytes of JSON on 1 thread, best of %d runs:\n", (size_t)data->json_size, bench);
+    for (i32 j = 0; j < 2; ++j) printf("  %-14s %.3f ms\n", names[j], best[j] * 1000.0);
+    
+    TmpBegin(&tmp, &arena);
+    
+    jsmntok_t *tokens = NULL;
+    int tokensCount = cgltf_parse_json_tokens_growing(&benchOptions, (const uint8_t *)data->json, data->json_size, &tokens);
+    CHECK(tokensCount > 0, "Failed to tokenize %s", inputPath);
+    
+    // Number tokens only, the fast path counts the ones it handles by itself
+    jsmntok_t *numbers = (jsmntok_t *)AllocNoZero(&arena, tokensCount * sizeof(jsmntok_t));
+    size_t numbersCount = 0, fastCount = 0;
+    for (int k = 0; k < tokensCount; ++k)
+    {
+      char first = data->json[tokens[k].start];
+      if (tokens[k].type != JSMN_PRIMITIVE || (first != '-' && (first < '0' || first > '9'))) continue;
+      double value;
+      numbers[numbersCount++] = tokens[k];
+      fastCount += cgltf_json_to_double_fast(data->json + tokens[k].start, (cgltf_size)(tokens[k].end - tokens[k].start), &value);
+    }
+    
+    f32 *results[2];
+    names[0] = "strtod";
+    names[1] = "fast path";
+    best[0] = best[1] = 1e30;
+    for (i32 j = 0; j < 2; ++j) results[j] = (f32 *)AllocNoZero(&arena, (numbersCount + 1) * sizeof(f32));
+    
+    for (i32 i = 0; i < bench; ++i)
+    {
+      f64 start = Clock();
+      for (size_t k = 0; k < numbersCount; ++k)
+      {
+        char number[128];
+        size_t length = MIN((size_t)(numbers[k].end - numbers[k].start), sizeof(number) - 1);
+        memcpy(number, data->json + numbers[k].start, length);
+        number[length] = 0;
+        results[0][k] = (f32)CGLTF_ATOF(number);
+      }
+      best[0] = MIN(best[0], Clock() - start);
+      
+      start = Clock();
+      for (size_t k = 0; k < numbersCount; ++k) results[1][k] = cgltf_json_to_float(&numbers[k], (const uint8_t *)data->json);
+      best[1] = MIN(best[1], Clock() - start);
+    }
     
-  // Writting to output
+    CHECK(memcmp(results[0], results[1], numbersCount * sizeof(f32)) == 0, "Fast path floats differ from strtod ones");
+    printf("floats of %zu number tokens (%.1f%% on the fast path), best of %d runs:\n",
+           numbersCount, numbersCount ? 100.0 * (f64)fastCount / (f64)numbersCount : 0.0, bench);
+    for (i32 j = 0; j < 2; ++j) printf("  %-14s %.3f ms\n", names[j], best[j] * 1000.0);
+    
+    // The chain tests every key cgltf_json_to_key knows in turn, as the object
+    // parsers used to, so it is longer than any single parser's chain
+    jsmntok_t *keys = numbers;
+    size_t keysCount = 0, knownCount = 0;
+    for (int k = 0; k < tokensCount; ++k)
+    {
+      if (tokens[k].type == JSMN_STRING && tokens[k].size == 1) keys[keysCount++] = tokens[k];
+    }
+    
+    cgltf_json_key *keyResults[2];
+    names[0] = "strcmp chain";
+    names[1] = "key switch";
+    best[0] = best[1] = 1e30;
+    for (i32 j = 0; j < 2; ++j) keyResults[j] = (cgltf_json_key *)AllocNoZero(&arena, (keysCount + 1) * sizeof(cgltf_json_key));
+    
+    for (i32 i = 0; i < bench; ++i)
+    {
+      f64 start = Clock();
+      for (size_t k = 0; k < keysCount; ++k)
+      {
+        i32 key = cgltf_json_key_pbr_metallic_roughness;
+        while (key > cgltf_json_key_unknown && cgltf_json_strcmp(&keys[k], (const uint8_t *)data->json, cgltf_json_key_names[key]) != 0) --key;
+        keyResults[0][k] = (cgltf_json_key)key;
+      }
+      best[0] = MIN(best[0], Clock() - start);
+      
+      start = Clock();
+      for (size_t k = 0; k < keysCount; ++k) keyResults[1][k] = cgltf_json_to_key(&keys[k], (const uint8_t *)data->json);
+      best[1] = MIN(best[1], Clock() - start);
+    }
+    
+    for (size_t k = 0; k < keysCount; ++k) knownCount += keyResults[1][k] != cgltf_json_key_unknown;
+    CHECK(memcmp(keyResults[0], keyResults[1], keysCount * sizeof(cgltf_json_key)) == 0, "Key switch differs from the strcmp chain");
+    printf("dispatch of %zu object keys (%.1f%% known), best of %d runs:\n",
+           keysCount, keysCount ? 100.0 * (f64)knownCount / (f64)keysCount : 0.0, bench);
+    for (i32 j = 0; j < 2; ++j) printf("  %-14s %.3f ms\n", names[j], best[j] * 1000.0);
+    
+    TmpEnd(&tmp);
+  }
   
-  HANDLE output = CreateFile(outputPath, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, 0, NULL);
+  // Writting header, boundaries are only known once vertices are extracted
   
-  CHECK(output != INVALID_HANDLE_VALUE, "Failed to write to %s", argv[2]);
-  CHECK(WriteFile(output, &model.indicesCount, 4 * sizeof(u32), 0, NULL), "Failed to write indices or vertices metadata in the header");
-  CHECK(WriteFile(output, model.uvScale, 10 * sizeof(f32), 0, NULL), "Failed to write material data in the header");
-  CHECK(WriteFile(output, model.minBoundary, 6 * sizeof(u16), 0, NULL), "Failed to write boundaries in the header");
-  CHECK(WriteFile(output, model.indices, model.indicesSize, 0, NULL), "Failed to write indices");
-  CHECK(WriteFile(output, model.vertices, model.verticesSize, 0, NULL), "Failed to write vertices");
+  uc *header = output.data;
+  memcpy(header, &model.indicesCount, 4 * sizeof(u32));
+  memcpy(header + 4 * sizeof(u32), model.uvScale, 10 * sizeof(f32));
+  memcpy(header + 4 * sizeof(u32) + 10 * sizeof(f32), model.minBoundary, 6 * sizeof(u16));
     
-  CloseHandle(output);
+  UnmapFile(&output);
+  for (cgltf_size i = 0; i < data->buffers_count; ++i) UnmapFile(&buffers[i].file);
+  UnmapFile(&cacheFile);
+  UnmapFile(&inputFile);
+  
+  if (stats)
+  {
+    f64 parseMs = (extractStart - parseStart) * 1000.0, extractMs = (extractEnd - extractStart) * 1000.0;
+    u16 *min = model.minBoundary, *max = model.maxBoundary;
+    f32 *center = model.sphereCenter;
+    
+    // --stats=json prints one record per run on a single line
+    if (statsJson) printf("{\"arenas\":[");
+    PrintArenaStats(stdout, &arena, "main", statsJson);
+    for (i32 i = 0; i < workers.count; ++i)
+    {
+      char name[16];
+      if (!workers.arenas[i].stats.allocCount) continue;
+      snprintf(name, sizeof(name), "worker%d", i);
+      if (statsJson) printf(",");
+      PrintArenaStats(stdout, &workers.arenas[i], name, statsJson);
+    }
+    
+    if (statsJson)
+    {
+      printf("],\"parseMs\":%.3f,\"extractMs\":%.3f,\"minBoundary\":[%u,%u,%u],\"maxBoundary\":[%u,%u,%u],"
+             "\"sphereCenter\":[%.1f,%.1f,%.1f],\"sphereRadius\":%.3f}\n", parseMs, extractMs,
+             min[0], min[1], min[2], max[0], max[1], max[2], center[0], center[1], center[2], model.sphereRadius);
+    }
+    else
+    {
+      printf("timings:\n  parse       %.3f ms\n  extract     %.3f ms\n", parseMs, extractMs);
+      printf("bounds:\n  min         %u %u %u\n  max         %u %u %u\n", min[0], min[1], min[2], max[0], max[1], max[2]);
+      printf("  sphere      %.1f %.1f %.1f r %.3f\n", center[0], center[1], center[2], model.sphereRadius);
+    }
+  }
+  
+  ReleaseWorkerPool(&workers);
+  ReleaseScratchArenas();
+  ReleaseArena(&arena);
   return 0;
 }
@@ -0,0 +1,120 @@
+/*
+  Copyright (c) 2025 Alexandre Perché (@vegasword)
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef MAX_WORKERS
+#define MAX_WORKERS 64
+#endif
+
+// Fixed set of workers, each owning an arena reserved like a scratch arena, its
+// size doesn't depend on the number of workers. Whatever a worker allocates
+// while running a task stays alive until the pool is released, so results
+// built on worker arenas can be handed back to the caller without copies.
+
+typedef struct WorkerPool {
+  i32 count;
+  Arena arenas[MAX_WORKERS];
+} WorkerPool;
+
+// Arena of the worker running on this thread, NULL outside of ParallelFor
+THREAD_LOCAL Arena *workerArena;
+
+typedef i32 (*ParallelTask)(void *data, size_t begin, size_t end);
+
+typedef struct ParallelJob {
+  ParallelTask task;
+  void *data;
+  size_t begin;
+  size_t end;
+  Arena *arena;
+  i32 result;
+} ParallelJob;
+
+void InitWorkerPool(WorkerPool *pool, i32 count)
+{
+  memset(pool, 0, sizeof(WorkerPool));
+  pool->count = count < 1 ? 1 : count > MAX_WORKERS ? MAX_WORKERS : count;
+}
+
+void ReleaseWorkerPool(WorkerPool *pool)
+{
+  for (i32 i = 0; i < pool->count; ++i)
+  {
+    if (pool->arenas[i].data) ReleaseArena(&pool->arenas[i]);
+  }
+  memset(pool, 0, sizeof(WorkerPool));
+}
+
+static void RunParallelJob(void *param)
+{
+  ParallelJob *job = (ParallelJob *)param;
+  Arena *outerArena = workerArena;
+  
+  workerArena = job->arena;
+  job->result = job->task(job->data, job->begin, job->end);
+  workerArena = outerArena;
+}
+
+// Splits [0, count) in one contiguous range per worker, the calling thread runs
+// the last one. Returns 0 or the first negative task result in range order.
+i32 ParallelFor(WorkerPool *pool, size_t count, ParallelTask task, void *data)
+{
+  ParallelJob jobs[MAX_WORKERS];
+  Thread threads[MAX_WORKERS];
+  i32 started[MAX_WORKERS] = {0};
+  i32 jobsCount = (size_t)pool->count < count ? pool->count : (i32)count;
+  
+  if (jobsCount == 0) return 0;
+  
+  for (i32 i = 0; i < jobsCount; ++i)
+  {
+    Arena *arena = &pool->arenas[i];
+    // Only reserved, what a worker actually allocates gets committed
+    if (!arena->data && !ReserveArena(arena, SCRATCH_ARENA_SIZE, 0)) return -1;
+    
+    jobs[i].task = task;
+    jobs[i].data = data;
+    jobs[i].begin = count * i / jobsCount;
+    jobs[i].end = count * (i + 1) / jobsCount;
+    jobs[i].arena = arena;
+    jobs[i].result = 0;
+  }
+  
+  // A worker that fails to start has its range run inline instead
+  for (i32 i = 0; i < jobsCount - 1; ++i)
+  {
+    started[i] = StartThread(&threads[i], RunParallelJob, &jobs[i]);
+    if (!started[i]) RunParallelJob(&jobs[i]);
+  }
+  
+  RunParallelJob(&jobs[jobsCount - 1]);
+  
+  for (i32 i = 0; i < jobsCount - 1; ++i)
+  {
+    if (started[i]) JoinThread(&threads[i]);
+  }
+  
+  for (i32 i = 0; i < jobsCount; ++i)
+  {
+    if (jobs[i].result < 0) return jobs[i].result;
+  }
+  
+  return 0;
+}
@@ -0,0 +1,440 @@
+/*
+  Copyright (c) 2025 Alexandre Perché (@vegasword)
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include "windows.h"
+// Token privileges used by ReserveHugePages live in advapi32
+#pragma comment(lib, "advapi32.lib")
+#else
+#include "fcntl.h"
+#include "unistd.h"
+#include "sys/mman.h"
+#include "sys/stat.h"
+#include "time.h"
+#include "pthread.h"
+#endif
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+// View of a whole file, the data pointer stays valid until UnmapFile.
+// MapFile maps an existing file read-only, MapFileCopyOnWrite maps it writable
+// with private pages that never reach the disk, CreateMappedFile creates a
+// writable file of a known size whose pages are written back on UnmapFile.
+
+typedef struct MappedFile {
+  uc *data;
+  u64 size;
+#ifdef _WIN32
+  HANDLE file;
+  HANDLE mapping;
+#else
+  i32 fd;
+#endif
+} MappedFile;
+
+// Joinable OS thread running entry(param) to completion.
+
+typedef void (*ThreadEntry)(void *param);
+
+typedef struct Thread {
+  ThreadEntry entry;
+  void *param;
+#ifdef _WIN32
+  HANDLE handle;
+#else
+  pthread_t handle;
+#endif
+} Thread;
+
+#ifdef _WIN32
+
+static i32 MapFileWithAccess(MappedFile *file, const char *path, i32 copyOnWrite)
+{
+  LARGE_INTEGER size;
+
+  file->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (file->file == INVALID_HANDLE_VALUE) return 0;
+
+  if (!GetFileSizeEx(file->file, &size) || size.QuadPart == 0)
+  {
+    CloseHandle(file->file);
+    return 0;
+  }
+
+  file->size = (u64)size.QuadPart;
+  file->mapping = CreateFileMappingA(file->file, NULL, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+  if (!file->mapping)
+  {
+    CloseHandle(file->file);
+    return 0;
+  }
+
+  file->data = (uc *)MapViewOfFile(file->mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+  if (!file->data)
+  {
+    CloseHandle(file->mapping);
+    CloseHandle(file->file);
+    return 0;
+  }
+
+  return 1;
+}
+
+i32 CreateMappedFile(MappedFile *file, const char *path, u64 size)
+{
+  file->file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, 0, NULL);
+  if (file->file == INVALID_HANDLE_VALUE) return 0;
+
+  file->size = size;
+  file->mapping = CreateFileMappingA(file->file, NULL, PAGE_READWRITE, (DWORD)(size >> 32), (DWORD)size, NULL);
+  if (!file->mapping)
+  {
+    CloseHandle(file->file);
+    DeleteFileA(path);
+    return 0;
+  }
+
+  file->data = (uc *)MapViewOfFile(file->mapping, FILE_MAP_WRITE, 0, 0, 0);
+  if (!file->data)
+  {
+    CloseHandle(file->mapping);
+    CloseHandle(file->file);
+    DeleteFileA(path);
+    return 0;
+  }
+
+  return 1;
+}
+
+void UnmapFile(MappedFile *file)
+{
+  if (file->data) UnmapViewOfFile(file->data);
+  if (file->mapping) CloseHandle(file->mapping);
+  if (file->file && file->file != INVALID_HANDLE_VALUE) CloseHandle(file->file);
+  memset(file, 0, sizeof(MappedFile));
+}
+
+void *ReservePages(size_t size)
+{
+  return VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+i32 CommitPages(void *pages, size_t size)
+{
+  return VirtualAlloc(pages, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+}
+
+// Large pages can't be committed lazily on Win32 and stay resident, so only the
+// first hugeSize bytes are committed as large pages. The rest of the range is
+// reserved right after them with regular pages, committed on demand. Requires
+// the "Lock pages in memory" privilege.
+void *ReserveHugePages(size_t size, size_t hugeSize, size_t *committed)
+{
+  HANDLE token;
+  TOKEN_PRIVILEGES privileges = {0};
+  size_t largePageSize = GetLargePageMinimum();
+  if (!largePageSize) return NULL;
+
+  if (OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+  {
+    privileges.PrivilegeCount = 1;
+    privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+    if (LookupPrivilegeValueA(NULL, "SeLockMemoryPrivilege", &privileges.Privileges[0].Luid))
+    {
+      AdjustTokenPrivileges(token, FALSE, &privileges, 0, NULL, NULL);
+    }
+    CloseHandle(token);
+  }
+
+  size = (size + largePageSize - 1) & ~(largePageSize - 1);
+  hugeSize = (hugeSize + largePageSize - 1) & ~(largePageSize - 1);
+  if (hugeSize > size) hugeSize = size;
+  
+  uc *pages = (uc *)VirtualAlloc(NULL, hugeSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+  if (!pages) return NULL;
+  
+  if (size > hugeSize && !VirtualAlloc(pages + hugeSize, size - hugeSize, MEM_RESERVE, PAGE_NOACCESS))
+  {
+    VirtualFree(pages, 0, MEM_RELEASE);
+    return NULL;
+  }
+  
+  *committed = hugeSize;
+  return pages;
+}
+
+// A range may span several allocations (see ReserveHugePages), each one is
+// released from its base.
+void ReleasePages(void *pages, size_t size)
+{
+  uc *at = (uc *)pages;
+  uc *end = at + size;
+  MEMORY_BASIC_INFORMATION info;
+  
+  while (at < end && VirtualQuery(at, &info, sizeof(info)))
+  {
+    void *base = info.AllocationBase;
+    do at = (uc *)info.BaseAddress + info.RegionSize;
+    while (at < end && VirtualQuery(at, &info, sizeof(info)) && info.AllocationBase == base);
+    VirtualFree(base, 0, MEM_RELEASE);
+  }
+}
+
+f64 Clock(void)
+{
+  LARGE_INTEGER counter, frequency;
+  QueryPerformanceCounter(&counter);
+  QueryPerformanceFrequency(&frequency);
+  return (f64)counter.QuadPart / (f64)frequency.QuadPart;
+}
+
+static DWORD WINAPI ThreadProc(LPVOID param)
+{
+  Thread *thread = (Thread *)param;
+  thread->entry(thread->param);
+  return 0;
+}
+
+i32 StartThread(Thread *thread, ThreadEntry entry, void *param)
+{
+  thread->entry = entry;
+  thread->param = param;
+  thread->handle = CreateThread(NULL, 0, ThreadProc, thread, 0, NULL);
+  return thread->handle != NULL;
+}
+
+void JoinThread(Thread *thread)
+{
+  WaitForSingleObject(thread->handle, INFINITE);
+  CloseHandle(thread->handle);
+}
+
+i32 CpuCount(void)
+{
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return (i32)info.dwNumberOfProcessors;
+}
+
+#else
+
+static i32 MapFileWithAccess(MappedFile *file, const char *path, i32 copyOnWrite)
+{
+  struct stat st;
+
+  file->fd = open(path, O_RDONLY);
+  if (file->fd < 0) return 0;
+
+  if (fstat(file->fd, &st) != 0 || st.st_size == 0)
+  {
+    close(file->fd);
+    return 0;
+  }
+
+  file->size = (u64)st.st_size;
+  file->data = (uc *)mmap(NULL, file->size, copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, file->fd, 0);
+  if (file->data == MAP_FAILED)
+  {
+    file->data = NULL;
+    close(file->fd);
+    return 0;
+  }
+
+  // Attributes are streamed front to back, let the kernel read ahead aggressively
+  madvise(file->data, file->size, MADV_SEQUENTIAL);
+  madvise(file->data, file->size, MADV_WILLNEED);
+
+  return 1;
+}
+
+i32 CreateMappedFile(MappedFile *file, const char *path, u64 size)
+{
+  file->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (file->fd < 0) return 0;
+
+  if (ftruncate(file->fd, (off_t)size) != 0)
+  {
+    close(file->fd);
+    unlink(path);
+    return 0;
+  }
+
+  file->size = size;
+  file->data = (uc *)mmap(NULL, file->size, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, 0);
+  if (file->data == MAP_FAILED)
+  {
+    file->data = NULL;
+    close(file->fd);
+    unlink(path);
+    return 0;
+  }
+
+  return 1;
+}
+
+void UnmapFile(MappedFile *file)
+{
+  if (file->data)
+  {
+    munmap(file->data, file->size);
+    close(file->fd);
+  }
+  memset(file, 0, sizeof(MappedFile));
+}
+
+void *ReservePages(size_t size)
+{
+  void *pages = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  return pages == MAP_FAILED ? NULL : pages;
+}
+
+i32 CommitPages(void *pages, size_t size)
+{
+  return mprotect(pages, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+// Transparent huge pages only back 2 MB aligned ranges, the reservation is
+// over-allocated then trimmed to be aligned on both ends. Only the first
+// hugeSize bytes are advised, like on Win32, all of it is committed lazily.
+void *ReserveHugePages(size_t size, size_t hugeSize, size_t *committed)
+{
+  size = (size + HUGE_PAGE_SIZE - 1) & ~((size_t)HUGE_PAGE_SIZE - 1);
+  hugeSize = (hugeSize + HUGE_PAGE_SIZE - 1) & ~((size_t)HUGE_PAGE_SIZE - 1);
+  if (hugeSize > size) hugeSize = size;
+  uc *pages = (uc *)mmap(NULL, size + HUGE_PAGE_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (pages == MAP_FAILED) return NULL;
+
+  uc *aligned = (uc *)(((uintptr_t)pages + HUGE_PAGE_SIZE - 1) & ~((uintptr_t)HUGE_PAGE_SIZE - 1));
+  if (aligned > pages) munmap(pages, aligned - pages);
+  munmap(aligned + size, (pages + HUGE_PAGE_SIZE) - aligned);
+
+  if (madvise(aligned, hugeSize, MADV_HUGEPAGE) != 0)
+  {
+    munmap(aligned, size);
+    return NULL;
+  }
+
+  *committed = 0;
+  return aligned;
+}
+
+void ReleasePages(void *pages, size_t size)
+{
+  munmap(pages, size);
+}
+
+f64 Clock(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (f64)now.tv_sec + (f64)now.tv_nsec * 1e-9;
+}
+
+static void *ThreadProc(void *param)
+{
+  Thread *thread = (Thread *)param;
+  thread->entry(thread->param);
+  return NULL;
+}
+
+i32 StartThread(Thread *thread, ThreadEntry entry, void *param)
+{
+  thread->entry = entry;
+  thread->param = param;
+  return pthread_create(&thread->handle, NULL, ThreadProc, thread) == 0;
+}
+
+void JoinThread(Thread *thread)
+{
+  pthread_join(thread->handle, NULL);
+}
+
+i32 CpuCount(void)
+{
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? (i32)count : 1;
+}
+
+#endif
+
+i32 MapFile(MappedFile *file, const char *path)
+{
+  return MapFileWithAccess(file, path, 0);
+}
+
+i32 MapFileCopyOnWrite(MappedFile *file, const char *path)
+{
+  return MapFileWithAccess(file, path, 1);
+}
+
+// Instruction sets the vectorized kernels can be dispatched to at runtime
+
+typedef struct CpuFeatures {
+  i32 sse41;
+  i32 avx2;
+} CpuFeatures;
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+
+#include "intrin.h"
+
+CpuFeatures GetCpuFeatures(void)
+{
+  CpuFeatures features = {0};
+  i32 info[4];
+  
+  __cpuid(info, 0);
+  i32 maxLeaf = info[0];
+  
+  __cpuid(info, 1);
+  features.sse41 = (info[2] >> 19) & 1;
+  
+  // AVX state must also be enabled by the OS (OSXSAVE and XCR0 bits), AVX2 is
+  // only reported by leaf 7 which older CPUs don't have
+  i32 avx = ((info[2] >> 28) & 1) && ((info[2] >> 27) & 1) && (_xgetbv(0) & 6) == 6;
+  if (avx && maxLeaf >= 7)
+  {
+    __cpuidex(info, 7, 0);
+    features.avx2 = (info[1] >> 5) & 1;
+  }
+  return features;
+}
+
+#elif defined(__x86_64__) || defined(__i386__)
+
+CpuFeatures GetCpuFeatures(void)
+{
+  CpuFeatures features = {0};
+  __builtin_cpu_init();
+  features.sse41 = __builtin_cpu_supports("sse4.1") != 0;
+  features.avx2 = __builtin_cpu_supports("avx2") != 0;
+  return features;
+}
+
+#else
+
+CpuFeatures GetCpuFeatures(void)
+{
+  CpuFeatures features = {0};
+  return features;
+}
+
+#endif